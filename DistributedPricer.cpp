@@ -0,0 +1,207 @@
+#include "DistributedPricer.hpp"
+#include "MonteCarlo.hpp"
+#include "Option.hpp"
+#include "PricingWorkspace.hpp"
+#include "StatFunctions.hpp"
+#include <algorithm>
+#include <cmath>
+#include <csignal>
+#include <stdexcept>
+#include <sys/wait.h>
+#include <tuple>
+#include <unistd.h>
+#include <vector>
+
+// pairwise update of Chan et al., exact for any split of the paths and stable when payoffs are large relative to their spread
+PricingAccumulator &operator+=(PricingAccumulator &lhs, const PricingAccumulator &rhs) {
+  if (rhs.count == 0) {
+    return lhs;
+  }
+  if (lhs.count == 0) {
+    lhs = rhs;
+    return lhs;
+  }
+
+  double count = static_cast<double>(lhs.count) + rhs.count;
+  double weight = static_cast<double>(lhs.count) * rhs.count / count;
+  double delta_call = rhs.mean_call - lhs.mean_call;
+  double delta_put = rhs.mean_put - lhs.mean_put;
+  lhs.mean_call += delta_call * rhs.count / count;
+  lhs.m2_call += rhs.m2_call + delta_call * delta_call * weight;
+  lhs.mean_put += delta_put * rhs.count / count;
+  lhs.m2_put += rhs.m2_put + delta_put * delta_put * weight;
+  lhs.count += rhs.count;
+
+  return lhs;
+}
+
+static bool write_all(int fd, const char *data, size_t size) {
+  while (size > 0) {
+    ssize_t written = write(fd, data, size);
+    if (written <= 0) {
+      return false;
+    }
+    data += written;
+    size -= written;
+  }
+  return true;
+}
+
+static bool read_all(int fd, char *data, size_t size) {
+  while (size > 0) {
+    ssize_t got = read(fd, data, size);
+    if (got <= 0) {
+      return false;
+    }
+    data += got;
+    size -= got;
+  }
+  return true;
+}
+
+// kills and reaps the workers already started and closes their pipes, used when a later worker cannot be started
+static void abandon_workers(const std::vector<pid_t> &pids, const std::vector<int> &pipes, int started) {
+  for (int w = 0; w < started; ++w) {
+    close(pipes[w]);
+    kill(pids[w], SIGKILL);
+    waitpid(pids[w], nullptr, 0);
+  }
+}
+
+static ErrorData error_data(const Option &option, const double mean, const double m2, const int count) {
+  double price = option.discount(mean);
+  double std_err = option.std_error(m2 / count, count);
+
+  return ErrorData{std_err, CONFIDENCE, price - CRITICAL_VALUE * std_err, price + CRITICAL_VALUE * std_err};
+}
+
+DistributedPricer::DistributedPricer(int workers, unsigned int seed) : workers(workers), seed(seed) {
+  if (workers <= 0) {
+    throw std::invalid_argument("workers must be positive");
+  }
+}
+
+DistributedPricer::~DistributedPricer() {}
+
+void DistributedPricer::price_blocks(const Option &option, int timesteps, int simulations, PricingWorkspace &workspace, int first_block,
+                                     int last_block, PricingAccumulator *partials) const {
+  for (int b = first_block; b < last_block; ++b) {
+    int paths = std::min(DISTRIBUTED_BLOCK_SIZE, simulations - b * DISTRIBUTED_BLOCK_SIZE);
+    option.generator().seed(seed, b);
+    option(timesteps, paths, workspace);
+
+    const std::vector<double> &pay_offs_call = workspace.pay_offs_call();
+    const std::vector<double> &pay_offs_put = workspace.pay_offs_put();
+    // two passes, as compute_average and compute_variance do, so a single block matches the in-process pricer exactly
+    double mean_call = compute_average(pay_offs_call);
+    double mean_put = compute_average(pay_offs_put);
+    double m2_call{0.0};
+    double m2_put{0.0};
+    for (int i = 0; i < paths; ++i) {
+      m2_call += (pay_offs_call[i] - mean_call) * (pay_offs_call[i] - mean_call);
+      m2_put += (pay_offs_put[i] - mean_put) * (pay_offs_put[i] - mean_put);
+    }
+    partials[b - first_block] = PricingAccumulator{paths, mean_call, m2_call, mean_put, m2_put};
+  }
+}
+
+std::tuple<double, double, ErrorData, ErrorData> DistributedPricer::operator()(const Option &option, int timesteps, int simulations,
+                                                                               PricingWorkspace &workspace) const {
+  if (simulations <= 0) {
+    throw std::invalid_argument("simulations must be positive");
+  }
+  // a path cache only notices grid changes, it would serve the first block's paths for every block
+  if (option.has_path_cache()) {
+    throw std::invalid_argument("options with a path cache can't be priced block by block");
+  }
+
+  int blocks = (simulations + DISTRIBUTED_BLOCK_SIZE - 1) / DISTRIBUTED_BLOCK_SIZE;
+  int processes = std::min(workers, blocks);
+  std::vector<PricingAccumulator> partials(blocks);
+
+  if (processes == 1) {
+    // the blocks reseed the shared generator, put its state back so that later pricings draw the same numbers whatever
+    // the number of workers
+    MonteCarlo &mc = option.generator();
+    MonteCarlo saved = mc;
+    try {
+      price_blocks(option, timesteps, simulations, workspace, 0, blocks, partials.data());
+    } catch (...) {
+      mc = saved;
+      throw;
+    }
+    mc = saved;
+  } else {
+    std::vector<pid_t> pids(processes);
+    std::vector<int> pipes(processes);
+    std::vector<int> first_blocks(processes + 1);
+    for (int w = 0; w <= processes; ++w) {
+      first_blocks[w] = static_cast<int>(static_cast<long>(w) * blocks / processes);
+    }
+
+    for (int w = 0; w < processes; ++w) {
+      int fds[2];
+      if (pipe(fds) != 0) {
+        abandon_workers(pids, pipes, w);
+        throw std::runtime_error("could not create pipe to worker");
+      }
+      pid_t pid = fork();
+      if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        abandon_workers(pids, pipes, w);
+        throw std::runtime_error("could not fork worker");
+      }
+
+      if (pid == 0) {
+        // worker: price its slice and stream the block partials back, _exit skips the parent's atexit handlers and buffers
+        close(fds[0]);
+        int status = 0;
+        try {
+          std::vector<PricingAccumulator> slice(first_blocks[w + 1] - first_blocks[w]);
+          price_blocks(option, timesteps, simulations, workspace, first_blocks[w], first_blocks[w + 1], slice.data());
+          if (!write_all(fds[1], reinterpret_cast<const char *>(slice.data()), slice.size() * sizeof(PricingAccumulator))) {
+            status = 1;
+          }
+        } catch (...) {
+          status = 1;
+        }
+        close(fds[1]);
+        _exit(status);
+      }
+
+      close(fds[1]);
+      pids[w] = pid;
+      pipes[w] = fds[0];
+    }
+
+    bool failed = false;
+    for (int w = 0; w < processes; ++w) {
+      size_t size = (first_blocks[w + 1] - first_blocks[w]) * sizeof(PricingAccumulator);
+      if (!read_all(pipes[w], reinterpret_cast<char *>(partials.data() + first_blocks[w]), size)) {
+        failed = true;
+      }
+      close(pipes[w]);
+
+      int status = 0;
+      if (waitpid(pids[w], &status, 0) != pids[w] || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        failed = true;
+      }
+    }
+    if (failed) {
+      throw std::runtime_error("pricing worker failed");
+    }
+  }
+
+  PricingAccumulator total{0, 0.0, 0.0, 0.0, 0.0};
+  for (const PricingAccumulator &partial : partials) {
+    total += partial;
+  }
+
+  double price_call = option.discount(total.mean_call);
+  double price_put = option.discount(total.mean_put);
+  ErrorData err_call = error_data(option, total.mean_call, total.m2_call, total.count);
+  ErrorData err_put = error_data(option, total.mean_put, total.m2_put, total.count);
+
+  return std::make_tuple(price_call, price_put, err_call, err_put);
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef DISTRIBUTEDPRICER_H
+#define DISTRIBUTEDPRICER_H
+
+#include "MonteCarlo.hpp"
+#include "Option.hpp"
+#include "PricingWorkspace.hpp"
+#include <tuple>
+#include <vector>
+
+const int DISTRIBUTED_BLOCK_SIZE = 1000;
+const unsigned int DISTRIBUTED_SEED = 987654321;
+
+// count, mean and sum of squared deviations (M2) of the payoffs of one or more blocks of paths, mergeable in any process
+struct PricingAccumulator {
+    int count;
+    double mean_call;
+    double m2_call;
+    double mean_put;
+    double m2_put;
+};
+
+PricingAccumulator &operator+=(PricingAccumulator &lhs, const PricingAccumulator &rhs);
+
+// Splits the path index space in fixed size blocks, each simulated on its own generator stream, and hands contiguous
+// ranges of blocks to forked worker processes. Block partials are merged in block order by the coordinator, so the
+// price does not depend on the number of workers. Meant for products whose paths are priced independently of each
+// other: an early exercise option would fit its exercise boundary per block.
+class DistributedPricer {
+  public:
+    DistributedPricer(int workers, unsigned int seed);
+    ~DistributedPricer();
+
+    // the option's generator is reseeded per block and left in its original state
+    std::tuple<double, double, ErrorData, ErrorData> operator()(const Option &option, int timesteps, int simulations,
+                                                                PricingWorkspace &workspace) const;
+
+  private:
+    int workers;
+    unsigned int seed;
+
+    void price_blocks(const Option &option, int timesteps, int simulations, PricingWorkspace &workspace, int first_block, int last_block,
+                      PricingAccumulator *partials) const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,323 @@
+#include "LongstaffSchwartz.hpp"
+#include "MonteCarlo.hpp"
+#include "Option.hpp"
+#include "PricingWorkspace.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// per thread accumulator layout: BASIS_SIZE x BASIS_SIZE normal matrix, BASIS_SIZE right hand side, in the money count
+const int PARTIAL_SIZE = BASIS_SIZE * BASIS_SIZE + BASIS_SIZE + 1;
+
+static void fill_basis(double *basis, const double x, const double y) {
+  basis[0] = 1.0;
+  basis[1] = x;
+  basis[2] = y;
+  basis[3] = x * x;
+  basis[4] = x * y;
+  basis[5] = y * y;
+}
+
+static double continuation_value(const double *coefficients, const double *basis) {
+  double value{0.0};
+  for (int i = 0; i < BASIS_SIZE; ++i) {
+    value += coefficients[i] * basis[i];
+  }
+  return value;
+}
+
+// solves a x = b for the symmetric normal matrix a with a Cholesky factorisation, a and b are overwritten
+static bool solve_normal_equations(double *a, double *b) {
+  for (int j = 0; j < BASIS_SIZE; ++j) {
+    double pivot = a[j * BASIS_SIZE + j];
+    for (int k = 0; k < j; ++k) {
+      pivot -= a[j * BASIS_SIZE + k] * a[j * BASIS_SIZE + k];
+    }
+    if (pivot <= 1e-12) {
+      return false;
+    }
+    a[j * BASIS_SIZE + j] = std::sqrt(pivot);
+
+    for (int i = j + 1; i < BASIS_SIZE; ++i) {
+      double value = a[i * BASIS_SIZE + j];
+      for (int k = 0; k < j; ++k) {
+        value -= a[i * BASIS_SIZE + k] * a[j * BASIS_SIZE + k];
+      }
+      a[i * BASIS_SIZE + j] = value / a[j * BASIS_SIZE + j];
+    }
+  }
+
+  for (int i = 0; i < BASIS_SIZE; ++i) {
+    for (int k = 0; k < i; ++k) {
+      b[i] -= a[i * BASIS_SIZE + k] * b[k];
+    }
+    b[i] /= a[i * BASIS_SIZE + i];
+  }
+  for (int i = BASIS_SIZE - 1; i >= 0; --i) {
+    for (int k = i + 1; k < BASIS_SIZE; ++k) {
+      b[i] -= a[k * BASIS_SIZE + i] * b[k];
+    }
+    b[i] /= a[i * BASIS_SIZE + i];
+  }
+
+  return true;
+}
+
+LongstaffSchwartz::LongstaffSchwartz(int exercise_dates, int regression_simulations, int threads)
+    : exercise_dates(exercise_dates), regression_simulations(regression_simulations), threads(threads), generation(0), pending(0),
+      stopping(false), phase(Phase::Accumulate), date_spots(nullptr), date_stats(nullptr), date_coefficients(nullptr),
+      date_exercise(nullptr), date_growth(0.0), date_scale(0.0) {
+  if (exercise_dates <= 0 || regression_simulations <= 0 || threads <= 0) {
+    throw std::invalid_argument("exercise dates, regression simulations and threads must be positive");
+  }
+
+  workers.reserve(threads - 1);
+  for (int t = 0; t < threads - 1; ++t) {
+    workers.emplace_back(&LongstaffSchwartz::worker_loop, this, t);
+  }
+}
+
+LongstaffSchwartz::~LongstaffSchwartz() {
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    stopping = true;
+  }
+  start_condition.notify_all();
+
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+}
+
+void LongstaffSchwartz::worker_loop(int t) {
+  unsigned long seen = 0;
+
+  while (true) {
+    std::unique_lock<std::mutex> lock(pool_mutex);
+    start_condition.wait(lock, [this, seen] {
+      return stopping || generation != seen;
+    });
+    if (stopping) {
+      return;
+    }
+    seen = generation;
+    lock.unlock();
+
+    run_chunk(t);
+
+    lock.lock();
+    if (--pending == 0) {
+      done_condition.notify_one();
+    }
+  }
+}
+
+// runs the current phase on every thread and returns once all chunks are done
+void LongstaffSchwartz::dispatch(Phase phase) {
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    this->phase = phase;
+    pending = threads - 1;
+    ++generation;
+  }
+  start_condition.notify_all();
+
+  run_chunk(threads - 1);
+
+  std::unique_lock<std::mutex> lock(pool_mutex);
+  done_condition.wait(lock, [this] {
+    return pending == 0;
+  });
+}
+
+// thread t handles the t-th contiguous chunk of the regression paths
+void LongstaffSchwartz::run_chunk(int t) {
+  const int n = regression_simulations;
+  const int chunk = (n + threads - 1) / threads;
+  const int begin = std::min(n, t * chunk);
+  const int end = std::min(n, begin + chunk);
+  const std::function<double(const double, const double)> &exercise = *date_exercise;
+  double basis[BASIS_SIZE];
+
+  if (phase == Phase::Accumulate) {
+    double *partial = partials.data() + t * PARTIAL_SIZE;
+    double *ata = partial;
+    double *atb = partial + BASIS_SIZE * BASIS_SIZE;
+    std::fill(partial, partial + PARTIAL_SIZE, 0.0);
+
+    for (int p = begin; p < end; ++p) {
+      if (exercise(date_stats[p], date_spots[p]) <= 0.0) {
+        continue;
+      }
+      fill_basis(basis, date_spots[p] * date_scale, date_stats[p] * date_scale);
+      for (int i = 0; i < BASIS_SIZE; ++i) {
+        for (int j = 0; j < BASIS_SIZE; ++j) {
+          ata[i * BASIS_SIZE + j] += basis[i] * basis[j];
+        }
+        atb[i] += basis[i] * cash_flows[p];
+      }
+      partial[PARTIAL_SIZE - 1] += 1.0;
+    }
+    return;
+  }
+
+  for (int p = begin; p < end; ++p) {
+    double exercise_value = exercise(date_stats[p], date_spots[p]) * date_growth;
+    if (exercise_value <= 0.0) {
+      continue;
+    }
+    fill_basis(basis, date_spots[p] * date_scale, date_stats[p] * date_scale);
+    if (exercise_value > continuation_value(date_coefficients, basis)) {
+      cash_flows[p] = exercise_value;
+    }
+  }
+}
+
+int LongstaffSchwartz::exercise_index(int k, int timesteps) const {
+  return (k * (timesteps - 1)) / exercise_dates;
+}
+
+void LongstaffSchwartz::simulate_regression_paths(MonteCarlo &mc, const OptionsParams &options_params, int timesteps,
+                                                  PricingWorkspace &workspace,
+                                                  double (*update_stat_call)(const double, const double, const int),
+                                                  double (*update_stat_put)(const double, const double, const int)) {
+  std::vector<double> &prices = workspace.path();
+  spots.resize(exercise_dates * regression_simulations);
+  stats_call.resize(exercise_dates * regression_simulations);
+  stats_put.resize(exercise_dates * regression_simulations);
+
+  // paths come out of the generator one at a time and are scattered into the timestep-major blocks so that the
+  // backward induction reads every exercise date contiguously
+  for (int p = 0; p < regression_simulations; ++p) {
+    mc.simulate_price_path(prices, options_params.S0, options_params.r, options_params.sigma, options_params.T);
+    double stat_call = prices[0];
+    double stat_put = prices[0];
+    int k = 1;
+
+    for (int j = 1; j < timesteps; ++j) {
+      stat_call = update_stat_call(stat_call, prices[j], j + 1);
+      stat_put = update_stat_put(stat_put, prices[j], j + 1);
+      if (j == exercise_index(k, timesteps)) {
+        spots[(k - 1) * regression_simulations + p] = prices[j];
+        stats_call[(k - 1) * regression_simulations + p] = stat_call;
+        stats_put[(k - 1) * regression_simulations + p] = stat_put;
+        ++k;
+      }
+    }
+  }
+}
+
+void LongstaffSchwartz::regress(const OptionsParams &options_params, int timesteps, const std::vector<double> &stats,
+                                const std::function<double(const double, const double)> &exercise, std::vector<double> &coefficients,
+                                std::vector<char> &regressed) {
+  const int n = regression_simulations;
+  const double dt = options_params.T / timesteps;
+  const double scale = 1.0 / options_params.S0;
+  cash_flows.resize(n);
+  coefficients.assign(exercise_dates * BASIS_SIZE, 0.0);
+  regressed.assign(exercise_dates, 0);
+  partials.resize(threads * PARTIAL_SIZE);
+
+  const double *maturity_spots = spots.data() + (exercise_dates - 1) * n;
+  const double *maturity_stats = stats.data() + (exercise_dates - 1) * n;
+  for (int p = 0; p < n; ++p) {
+    cash_flows[p] = exercise(maturity_stats[p], maturity_spots[p]);
+  }
+
+  // cash flows are kept compounded to maturity so that they can be compared across exercise dates without discounting
+  date_exercise = &exercise;
+  date_scale = scale;
+  for (int k = exercise_dates - 1; k >= 1; --k) {
+    double *coefficients_row = coefficients.data() + (k - 1) * BASIS_SIZE;
+    date_growth = std::exp(options_params.r * (options_params.T - exercise_index(k, timesteps) * dt));
+    date_spots = spots.data() + (k - 1) * n;
+    date_stats = stats.data() + (k - 1) * n;
+    date_coefficients = coefficients_row;
+
+    dispatch(Phase::Accumulate);
+
+    double system[PARTIAL_SIZE] = {};
+    for (int t = 0; t < threads; ++t) {
+      for (int i = 0; i < PARTIAL_SIZE; ++i) {
+        system[i] += partials[t * PARTIAL_SIZE + i];
+      }
+    }
+    // too few paths in the money to fit the basis: no exercise at this date
+    if (system[PARTIAL_SIZE - 1] < BASIS_SIZE || !solve_normal_equations(system, system + BASIS_SIZE * BASIS_SIZE)) {
+      continue;
+    }
+    std::copy(system + BASIS_SIZE * BASIS_SIZE, system + BASIS_SIZE * BASIS_SIZE + BASIS_SIZE, coefficients_row);
+    regressed[k - 1] = 1;
+
+    dispatch(Phase::Update);
+  }
+}
+
+void LongstaffSchwartz::price(MonteCarlo &mc, const OptionsParams &options_params, int timesteps, int simulations,
+                              PricingWorkspace &workspace, double (*update_stat_call)(const double, const double, const int),
+                              double (*update_stat_put)(const double, const double, const int),
+                              std::function<double(const double, const double)> exercise_call,
+                              std::function<double(const double, const double)> exercise_put) {
+  if (timesteps - 1 < exercise_dates) {
+    throw std::invalid_argument("not enough timesteps for the number of exercise dates");
+  }
+
+  workspace.reserve(timesteps, simulations);
+  simulate_regression_paths(mc, options_params, timesteps, workspace, update_stat_call, update_stat_put);
+  regress(options_params, timesteps, stats_call, exercise_call, coefficients_call, regressed_call);
+  regress(options_params, timesteps, stats_put, exercise_put, coefficients_put, regressed_put);
+
+  std::vector<double> &prices = workspace.path();
+  std::vector<double> &pay_offs_call = workspace.pay_offs_call();
+  std::vector<double> &pay_offs_put = workspace.pay_offs_put();
+  const double dt = options_params.T / timesteps;
+  const double scale = 1.0 / options_params.S0;
+  double basis[BASIS_SIZE];
+
+  for (int i = 0; i < simulations; ++i) {
+    mc.simulate_price_path(prices, options_params.S0, options_params.r, options_params.sigma, options_params.T);
+    double stat_call = prices[0];
+    double stat_put = prices[0];
+    bool exercised_call = false;
+    bool exercised_put = false;
+    int k = 1;
+
+    for (int j = 1; j < timesteps; ++j) {
+      stat_call = update_stat_call(stat_call, prices[j], j + 1);
+      stat_put = update_stat_put(stat_put, prices[j], j + 1);
+      if (k >= exercise_dates || j != exercise_index(k, timesteps)) {
+        continue;
+      }
+
+      double growth = std::exp(options_params.r * (options_params.T - j * dt));
+      if (!exercised_call && regressed_call[k - 1]) {
+        double exercise_value = exercise_call(stat_call, prices[j]) * growth;
+        fill_basis(basis, prices[j] * scale, stat_call * scale);
+        if (exercise_value > 0.0 && exercise_value > continuation_value(coefficients_call.data() + (k - 1) * BASIS_SIZE, basis)) {
+          pay_offs_call[i] = exercise_value;
+          exercised_call = true;
+        }
+      }
+      if (!exercised_put && regressed_put[k - 1]) {
+        double exercise_value = exercise_put(stat_put, prices[j]) * growth;
+        fill_basis(basis, prices[j] * scale, stat_put * scale);
+        if (exercise_value > 0.0 && exercise_value > continuation_value(coefficients_put.data() + (k - 1) * BASIS_SIZE, basis)) {
+          pay_offs_put[i] = exercise_value;
+          exercised_put = true;
+        }
+      }
+      ++k;
+    }
+
+    if (!exercised_call) {
+      pay_offs_call[i] = exercise_call(stat_call, prices.back());
+    }
+    if (!exercised_put) {
+      pay_offs_put[i] = exercise_put(stat_put, prices.back());
+    }
+  }
+}
\ No newline at end of file
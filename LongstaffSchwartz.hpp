@@ -0,0 +1,81 @@
+#ifndef LONGSTAFFSCHWARTZ_H
+#define LONGSTAFFSCHWARTZ_H
+
+#include "MonteCarlo.hpp"
+#include "PricingWorkspace.hpp"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// regression basis: 1, x, y, x^2, xy, y^2 with x the spot and y the running statistic, both scaled by S0
+const int BASIS_SIZE = 6;
+const int EXERCISE_DATES = 12;
+
+struct OptionsParams;
+
+// Longstaff-Schwartz early exercise engine. Exercise boundaries are regressed on a first set of paths and the
+// option is then priced on an independent forward set, so the boundary estimate does not bias the price upward.
+// The regression runs on a pool of threads - 1 workers started with the engine, the calling thread taking the last chunk.
+class LongstaffSchwartz {
+  public:
+    LongstaffSchwartz(int exercise_dates, int regression_simulations, int threads);
+    ~LongstaffSchwartz();
+
+    // fills workspace.pay_offs_call() and workspace.pay_offs_put() with the forward set cash flows, compounded to maturity
+    void price(MonteCarlo &mc, const OptionsParams &options_params, int timesteps, int simulations, PricingWorkspace &workspace,
+               double (*update_stat_call)(const double, const double, const int),
+               double (*update_stat_put)(const double, const double, const int),
+               std::function<double(const double, const double)> exercise_call,
+               std::function<double(const double, const double)> exercise_put);
+
+  private:
+    enum class Phase { Accumulate, Update };
+
+    int exercise_dates;
+    int regression_simulations;
+    int threads;
+
+    // timestep-major blocks: value of path p at exercise date k is stored at [k * regression_simulations + p]
+    std::vector<double> spots;
+    std::vector<double> stats_call;
+    std::vector<double> stats_put;
+    std::vector<double> cash_flows;
+    // one row of BASIS_SIZE coefficients per exercise date, plus whether the regression could be solved at that date
+    std::vector<double> coefficients_call;
+    std::vector<double> coefficients_put;
+    std::vector<char> regressed_call;
+    std::vector<char> regressed_put;
+    // per thread normal equation accumulators
+    std::vector<double> partials;
+
+    std::vector<std::thread> workers;
+    std::mutex pool_mutex;
+    std::condition_variable start_condition;
+    std::condition_variable done_condition;
+    unsigned long generation;
+    int pending;
+    bool stopping;
+    // exercise date currently handed to the pool
+    Phase phase;
+    const double *date_spots;
+    const double *date_stats;
+    const double *date_coefficients;
+    const std::function<double(const double, const double)> *date_exercise;
+    double date_growth;
+    double date_scale;
+
+    int exercise_index(int k, int timesteps) const;
+    void worker_loop(int t);
+    void dispatch(Phase phase);
+    void run_chunk(int t);
+    void simulate_regression_paths(MonteCarlo &mc, const OptionsParams &options_params, int timesteps, PricingWorkspace &workspace,
+                                   double (*update_stat_call)(const double, const double, const int),
+                                   double (*update_stat_put)(const double, const double, const int));
+    void regress(const OptionsParams &options_params, int timesteps, const std::vector<double> &stats,
+                 const std::function<double(const double, const double)> &exercise, std::vector<double> &coefficients,
+                 std::vector<char> &regressed);
+};
+
+#endif
\ No newline at end of file
@@ -8,6 +8,12 @@ MonteCarlo::MonteCarlo() {
 
 MonteCarlo::~MonteCarlo() {}
 
+// restarts the generator on an independent stream, so that a given block of paths is reproducible whichever process simulates it
+void MonteCarlo::seed(unsigned int seed, unsigned int stream) {
+  std::seed_seq sequence{seed, stream};
+  rd_generator.seed(sequence);
+}
+
 double MonteCarlo::generate_random_number() {
   std::normal_distribution<double> normal_dist{0.0, 1.0};
   return normal_dist(rd_generator);
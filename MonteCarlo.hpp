@@ -10,6 +10,7 @@ class MonteCarlo {
     MonteCarlo();
     ~MonteCarlo();
 
+    void seed(unsigned int seed, unsigned int stream);
     double generate_random_number();
     void simulate_price_path(std::vector<double> &prices, const double &S0, const double &r, const double &sigma, const double &T);
 
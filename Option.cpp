@@ -1,11 +1,14 @@
 #include "Option.hpp"
+#include "LongstaffSchwartz.hpp"
 #include "MonteCarlo.hpp"
+#include "PathCache.hpp"
 #include "PayOff.hpp"
+#include "PricingWorkspace.hpp"
 #include "StatFunctions.hpp"
+#include <algorithm>
 #include <cmath>
 #include <functional>
 #include <iostream>
-#include <memory>
 #include <stdexcept>
 #include <tuple>
 #include <utility>
@@ -24,46 +27,101 @@ std::ostream &operator<<(std::ostream &os, const ErrorData &err) {
   return os;
 }
 
-Option::Option(std::shared_ptr<MonteCarlo> mc, OptionsParams &options_params) : mc(mc), options_params(options_params) {}
+Option::Option(MonteCarlo &mc, OptionsParams &options_params) : mc(mc), options_params(options_params), path_cache(nullptr) {}
 
 Option::~Option() {}
 
-FixedStrikeOption::FixedStrikeOption(std::unique_ptr<PayOffFixedStrike> pay_off, std::shared_ptr<MonteCarlo> mc,
-                                     OptionsParams &options_params)
-    : Option(mc, options_params), pay_off(std::move(pay_off)) {}
+FixedStrikeOption::FixedStrikeOption(PayOffFixedStrike &pay_off, MonteCarlo &mc, OptionsParams &options_params)
+    : Option(mc, options_params), pay_off(pay_off) {}
 
 FixedStrikeOption::~FixedStrikeOption() {}
 
-FloatingStrikeOption::FloatingStrikeOption(std::unique_ptr<PayOffFloatingStrike> pay_off, std::shared_ptr<MonteCarlo> mc,
-                                           OptionsParams &options_params)
-    : Option(mc, options_params), pay_off(std::move(pay_off)) {}
+FloatingStrikeOption::FloatingStrikeOption(PayOffFloatingStrike &pay_off, MonteCarlo &mc, OptionsParams &options_params)
+    : Option(mc, options_params), pay_off(pay_off) {}
 
 FloatingStrikeOption::~FloatingStrikeOption() {}
 
-AsianFixedStrikeOption::AsianFixedStrikeOption(std::unique_ptr<PayOffFixedStrike> pay_off, std::shared_ptr<MonteCarlo> mc,
-                                               OptionsParams &options_params)
-    : FixedStrikeOption(std::move(pay_off), mc, options_params) {}
+AsianFixedStrikeOption::AsianFixedStrikeOption(PayOffFixedStrike &pay_off, MonteCarlo &mc, OptionsParams &options_params)
+    : FixedStrikeOption(pay_off, mc, options_params) {}
 
 AsianFixedStrikeOption::~AsianFixedStrikeOption() {}
 
-AsianFloatingStrikeOption::AsianFloatingStrikeOption(std::unique_ptr<PayOffFloatingStrike> pay_off, std::shared_ptr<MonteCarlo> mc,
-                                                     OptionsParams &options_params)
-    : FloatingStrikeOption(std::move(pay_off), mc, options_params) {}
+AsianFloatingStrikeOption::AsianFloatingStrikeOption(PayOffFloatingStrike &pay_off, MonteCarlo &mc, OptionsParams &options_params)
+    : FloatingStrikeOption(pay_off, mc, options_params) {}
 
 AsianFloatingStrikeOption::~AsianFloatingStrikeOption() {}
 
-LookbackFixedStrikeOption::LookbackFixedStrikeOption(std::unique_ptr<PayOffFixedStrike> pay_off, std::shared_ptr<MonteCarlo> mc,
-                                                     OptionsParams &options_params)
-    : FixedStrikeOption(std::move(pay_off), mc, options_params) {}
+LookbackFixedStrikeOption::LookbackFixedStrikeOption(PayOffFixedStrike &pay_off, MonteCarlo &mc, OptionsParams &options_params)
+    : FixedStrikeOption(pay_off, mc, options_params) {}
 
 LookbackFixedStrikeOption::~LookbackFixedStrikeOption() {}
 
-LookbackFloatingStrikeOption::LookbackFloatingStrikeOption(std::unique_ptr<PayOffFloatingStrike> pay_off, std::shared_ptr<MonteCarlo> mc,
+LookbackFloatingStrikeOption::LookbackFloatingStrikeOption(PayOffFloatingStrike &pay_off, MonteCarlo &mc,
                                                            OptionsParams &options_params)
-    : FloatingStrikeOption(std::move(pay_off), mc, options_params) {}
+    : FloatingStrikeOption(pay_off, mc, options_params) {}
 
 LookbackFloatingStrikeOption::~LookbackFloatingStrikeOption() {}
 
+BermudanAsianFixedStrikeOption::BermudanAsianFixedStrikeOption(PayOffFixedStrike &pay_off, MonteCarlo &mc,
+                                                               OptionsParams &options_params, LongstaffSchwartz &lsm)
+    : FixedStrikeOption(pay_off, mc, options_params), lsm(lsm) {}
+
+BermudanAsianFixedStrikeOption::~BermudanAsianFixedStrikeOption() {}
+
+BermudanAsianFloatingStrikeOption::BermudanAsianFloatingStrikeOption(PayOffFloatingStrike &pay_off, MonteCarlo &mc,
+                                                                     OptionsParams &options_params, LongstaffSchwartz &lsm)
+    : FloatingStrikeOption(pay_off, mc, options_params), lsm(lsm) {}
+
+BermudanAsianFloatingStrikeOption::~BermudanAsianFloatingStrikeOption() {}
+
+BermudanLookbackFixedStrikeOption::BermudanLookbackFixedStrikeOption(PayOffFixedStrike &pay_off, MonteCarlo &mc,
+                                                                     OptionsParams &options_params, LongstaffSchwartz &lsm)
+    : FixedStrikeOption(pay_off, mc, options_params), lsm(lsm) {}
+
+BermudanLookbackFixedStrikeOption::~BermudanLookbackFixedStrikeOption() {}
+
+BermudanLookbackFloatingStrikeOption::BermudanLookbackFloatingStrikeOption(PayOffFloatingStrike &pay_off, MonteCarlo &mc,
+                                                                           OptionsParams &options_params, LongstaffSchwartz &lsm)
+    : FloatingStrikeOption(pay_off, mc, options_params), lsm(lsm) {}
+
+BermudanLookbackFloatingStrikeOption::~BermudanLookbackFloatingStrikeOption() {}
+
+BarrierAsianFixedStrikeOption::BarrierAsianFixedStrikeOption(PayOffFixedStrike &pay_off, MonteCarlo &mc,
+                                                             OptionsParams &options_params)
+    : FixedStrikeOption(pay_off, mc, options_params) {}
+
+BarrierAsianFixedStrikeOption::~BarrierAsianFixedStrikeOption() {}
+
+BarrierAsianFloatingStrikeOption::BarrierAsianFloatingStrikeOption(PayOffFloatingStrike &pay_off, MonteCarlo &mc,
+                                                                   OptionsParams &options_params)
+    : FloatingStrikeOption(pay_off, mc, options_params) {}
+
+BarrierAsianFloatingStrikeOption::~BarrierAsianFloatingStrikeOption() {}
+
+BarrierLookbackFixedStrikeOption::BarrierLookbackFixedStrikeOption(PayOffFixedStrike &pay_off, MonteCarlo &mc,
+                                                                   OptionsParams &options_params)
+    : FixedStrikeOption(pay_off, mc, options_params) {}
+
+BarrierLookbackFixedStrikeOption::~BarrierLookbackFixedStrikeOption() {}
+
+BarrierLookbackFloatingStrikeOption::BarrierLookbackFloatingStrikeOption(PayOffFloatingStrike &pay_off, MonteCarlo &mc,
+                                                                         OptionsParams &options_params)
+    : FloatingStrikeOption(pay_off, mc, options_params) {}
+
+BarrierLookbackFloatingStrikeOption::~BarrierLookbackFloatingStrikeOption() {}
+
+void Option::set_path_cache(PathCache *path_cache) {
+  this->path_cache = path_cache;
+}
+
+bool Option::has_path_cache() const {
+  return this->path_cache != nullptr;
+}
+
+MonteCarlo &Option::generator() const {
+  return this->mc;
+}
+
 double Option::discount(const double s) const {
   return std::exp(-this->options_params.r * this->options_params.T) * s;
 }
@@ -72,11 +130,13 @@ double Option::std_error(const std::vector<double> &prices) const {
   if (prices.empty()) {
     throw std::invalid_argument("prices can't be empty");
   }
-  double variance = compute_variance(prices);
-  double avg = compute_average(prices);
+  return this->std_error(compute_variance(prices), prices.size());
+}
+
+double Option::std_error(const double variance, const int count) const {
   double discounted_var = std::exp(-2 * this->options_params.r * this->options_params.T) * variance;
 
-  return std::sqrt(discounted_var / prices.size());
+  return std::sqrt(discounted_var / count);
 }
 
 std::tuple<double, double, ErrorData, ErrorData> Option::compute_pricing_results(const std::vector<double> &pay_offs_call,
@@ -98,92 +158,320 @@ std::tuple<double, double, ErrorData, ErrorData> Option::compute_pricing_results
 }
 
 std::tuple<double, double, ErrorData, ErrorData>
-FixedStrikeOption::price_fixed_strike(int timesteps, int simulations, double (*stat_func_call)(const std::vector<double> &),
+Option::price_barrier(int timesteps, int simulations, PricingWorkspace &workspace, const PayOff &pay_off,
+                      double (*update_stat_call)(const double, const double, const int),
+                      double (*update_stat_put)(const double, const double, const int),
+                      std::function<double(const double, const double)> pay_off_func_call,
+                      std::function<double(const double, const double)> pay_off_func_put) const {
+  if (!pay_off.has_barrier()) {
+    throw std::invalid_argument("pay off has no barrier");
+  }
+
+  workspace.reserve(timesteps, simulations);
+  workspace.reserve_lanes(std::min(simulations, BARRIER_BATCH_SIZE));
+  std::vector<double> &pay_offs_call = workspace.pay_offs_call();
+  std::vector<double> &pay_offs_put = workspace.pay_offs_put();
+  std::vector<double> &spots = workspace.lane_spots();
+  std::vector<double> &stats_call = workspace.lane_stats_call();
+  std::vector<double> &stats_put = workspace.lane_stats_put();
+  std::vector<double> &survival = workspace.lane_survival();
+  std::vector<int> &paths = workspace.lane_paths();
+
+  const double sigma = this->options_params.sigma;
+  const double dt = this->options_params.T / timesteps;
+  const double drift = (this->options_params.r - 0.5 * sigma * sigma) * dt;
+  const double diffusion = sigma * std::sqrt(dt);
+  const bool knock_out = pay_off.is_knock_out();
+  const bool start_crossed = pay_off.is_crossed(this->options_params.S0);
+
+  // paths are simulated a batch at a time, one timestep across all live lanes per iteration. For knock-outs a lane
+  // that hits the barrier pays nothing, so it is dropped and the live lanes compacted to the front of the batch
+  for (int first = 0; first < simulations; first += BARRIER_BATCH_SIZE) {
+    int lanes = std::min(BARRIER_BATCH_SIZE, simulations - first);
+    for (int l = 0; l < lanes; ++l) {
+      spots[l] = this->options_params.S0;
+      stats_call[l] = this->options_params.S0;
+      stats_put[l] = this->options_params.S0;
+      survival[l] = start_crossed ? 0.0 : 1.0;
+      paths[l] = first + l;
+      pay_offs_call[first + l] = 0.0;
+      pay_offs_put[first + l] = 0.0;
+    }
+    if (knock_out && start_crossed) {
+      continue;
+    }
+
+    for (int j = 1; j < timesteps && lanes > 0; ++j) {
+      for (int l = 0; l < lanes; ++l) {
+        double previous = spots[l];
+        double s = previous * std::exp(drift + diffusion * mc.generate_random_number());
+        spots[l] = s;
+        stats_call[l] = update_stat_call(stats_call[l], s, j + 1);
+        stats_put[l] = update_stat_put(stats_put[l], s, j + 1);
+
+        if (survival[l] == 0.0) {
+          continue;
+        }
+        if (pay_off.is_crossed(s)) {
+          survival[l] = 0.0;
+        } else {
+          survival[l] *= 1.0 - pay_off.crossing_probability(previous, s, sigma, dt);
+        }
+      }
+
+      if (knock_out) {
+        int live = 0;
+        for (int l = 0; l < lanes; ++l) {
+          if (survival[l] == 0.0) {
+            continue;
+          }
+          spots[live] = spots[l];
+          stats_call[live] = stats_call[l];
+          stats_put[live] = stats_put[l];
+          survival[live] = survival[l];
+          paths[live] = paths[l];
+          ++live;
+        }
+        lanes = live;
+      }
+    }
+
+    for (int l = 0; l < lanes; ++l) {
+      double weight = knock_out ? survival[l] : 1.0 - survival[l];
+      pay_offs_call[paths[l]] = weight * pay_off_func_call(stats_call[l], spots[l]);
+      pay_offs_put[paths[l]] = weight * pay_off_func_put(stats_put[l], spots[l]);
+    }
+  }
+
+  return compute_pricing_results(pay_offs_call, pay_offs_put);
+}
+
+std::tuple<double, double, ErrorData, ErrorData>
+FixedStrikeOption::price_fixed_strike(int timesteps, int simulations, PricingWorkspace &workspace,
+                                      double (*stat_func_call)(const std::vector<double> &),
                                       double (*stat_func_put)(const std::vector<double> &),
                                       std::function<double(const double)> pay_off_func_call,
                                       std::function<double(const double)> pay_off_func_put) const {
-  std::vector<double> prices(timesteps);
-  std::vector<double> pay_offs_call;
-  std::vector<double> pay_offs_put;
+  workspace.reserve(timesteps, simulations);
+  std::vector<double> &prices = workspace.path();
+  std::vector<double> &pay_offs_call = workspace.pay_offs_call();
+  std::vector<double> &pay_offs_put = workspace.pay_offs_put();
+
+  if (this->path_cache != nullptr) {
+    this->path_cache->update(mc, this->options_params, timesteps, simulations, stat_func_call, stat_func_put, prices);
+    const std::vector<double> &stats_call = this->path_cache->stats(stat_func_call);
+    const std::vector<double> &stats_put = this->path_cache->stats(stat_func_put);
+    double scale = this->path_cache->scale(this->options_params);
+
+    for (int i = 0; i < simulations; ++i) {
+      pay_offs_call[i] = pay_off_func_call(stats_call[i] * scale);
+      pay_offs_put[i] = pay_off_func_put(stats_put[i] * scale);
+    }
+    return compute_pricing_results(pay_offs_call, pay_offs_put);
+  }
 
   for (int i = 0; i < simulations; ++i) {
-    mc->simulate_price_path(prices, this->options_params.S0, this->options_params.r, this->options_params.sigma, this->options_params.T);
+    mc.simulate_price_path(prices, this->options_params.S0, this->options_params.r, this->options_params.sigma, this->options_params.T);
     double stat_call = stat_func_call(prices);
     double stat_put = stat_func_put(prices);
     double pay_off_call = pay_off_func_call(stat_call);
     double pay_off_put = pay_off_func_put(stat_put);
 
-    pay_offs_call.push_back(pay_off_call);
-    pay_offs_put.push_back(pay_off_put);
+    pay_offs_call[i] = pay_off_call;
+    pay_offs_put[i] = pay_off_put;
   }
 
   return compute_pricing_results(pay_offs_call, pay_offs_put);
 }
 
 std::tuple<double, double, ErrorData, ErrorData>
-FloatingStrikeOption::price_floating_strike(int timesteps, int simulations, double (*stat_func_call)(const std::vector<double> &),
+FloatingStrikeOption::price_floating_strike(int timesteps, int simulations, PricingWorkspace &workspace,
+                                            double (*stat_func_call)(const std::vector<double> &),
                                             double (*stat_func_put)(const std::vector<double> &),
                                             std::function<double(const double, const double)> pay_off_func_call,
                                             std::function<double(const double, const double)> pay_off_func_put) const {
-  std::vector<double> prices(timesteps);
-  std::vector<double> pay_offs_call;
-  std::vector<double> pay_offs_put;
+  workspace.reserve(timesteps, simulations);
+  std::vector<double> &prices = workspace.path();
+  std::vector<double> &pay_offs_call = workspace.pay_offs_call();
+  std::vector<double> &pay_offs_put = workspace.pay_offs_put();
+
+  if (this->path_cache != nullptr) {
+    this->path_cache->update(mc, this->options_params, timesteps, simulations, stat_func_call, stat_func_put, prices);
+    const std::vector<double> &stats_call = this->path_cache->stats(stat_func_call);
+    const std::vector<double> &stats_put = this->path_cache->stats(stat_func_put);
+    const std::vector<double> &final_spots = this->path_cache->final_spots();
+    double scale = this->path_cache->scale(this->options_params);
+
+    for (int i = 0; i < simulations; ++i) {
+      pay_offs_call[i] = pay_off_func_call(stats_call[i] * scale, final_spots[i] * scale);
+      pay_offs_put[i] = pay_off_func_put(stats_put[i] * scale, final_spots[i] * scale);
+    }
+    return compute_pricing_results(pay_offs_call, pay_offs_put);
+  }
 
   for (int i = 0; i < simulations; ++i) {
-    mc->simulate_price_path(prices, this->options_params.S0, this->options_params.r, this->options_params.sigma, this->options_params.T);
+    mc.simulate_price_path(prices, this->options_params.S0, this->options_params.r, this->options_params.sigma, this->options_params.T);
     double stat_call = stat_func_call(prices);
     double stat_put = stat_func_put(prices);
     double s = prices.back();
     double pay_off_call = pay_off_func_call(stat_call, s);
     double pay_off_put = pay_off_func_put(stat_put, s);
 
-    pay_offs_call.push_back(pay_off_call);
-    pay_offs_put.push_back(pay_off_put);
+    pay_offs_call[i] = pay_off_call;
+    pay_offs_put[i] = pay_off_put;
   }
 
   return compute_pricing_results(pay_offs_call, pay_offs_put);
 }
 
-std::tuple<double, double, ErrorData, ErrorData> AsianFixedStrikeOption::operator()(int timesteps, int simulations) const {
+std::tuple<double, double, ErrorData, ErrorData> AsianFixedStrikeOption::operator()(int timesteps, int simulations,
+                                                                                    PricingWorkspace &workspace) const {
   return this->price_fixed_strike(
-      timesteps, simulations, &compute_average, &compute_average,
+      timesteps, simulations, workspace, &compute_average, &compute_average,
       [this](double avg) -> double {
-        return this->pay_off->call(avg);
+        return this->pay_off.call(avg);
       },
       [this](double avg) -> double {
-        return this->pay_off->put(avg);
+        return this->pay_off.put(avg);
       });
 }
 
-std::tuple<double, double, ErrorData, ErrorData> AsianFloatingStrikeOption::operator()(int timesteps, int simulations) const {
+std::tuple<double, double, ErrorData, ErrorData> AsianFloatingStrikeOption::operator()(int timesteps, int simulations,
+                                                                                       PricingWorkspace &workspace) const {
   return this->price_floating_strike(
-      timesteps, simulations, &compute_average, &compute_average,
+      timesteps, simulations, workspace, &compute_average, &compute_average,
       [this](double avg, double s) -> double {
-        return this->pay_off->call(avg, s);
+        return this->pay_off.call(avg, s);
       },
       [this](double avg, double s) -> double {
-        return this->pay_off->put(avg, s);
+        return this->pay_off.put(avg, s);
       });
 }
 
-std::tuple<double, double, ErrorData, ErrorData> LookbackFixedStrikeOption::operator()(int timesteps, int simulations) const {
+std::tuple<double, double, ErrorData, ErrorData> LookbackFixedStrikeOption::operator()(int timesteps, int simulations,
+                                                                                       PricingWorkspace &workspace) const {
   return this->price_fixed_strike(
-      timesteps, simulations, &find_max, &find_min,
+      timesteps, simulations, workspace, &find_max, &find_min,
       [this](double max) -> double {
-        return this->pay_off->call(max);
+        return this->pay_off.call(max);
       },
       [this](double min) -> double {
-        return this->pay_off->put(min);
+        return this->pay_off.put(min);
       });
 }
 
-std::tuple<double, double, ErrorData, ErrorData> LookbackFloatingStrikeOption::operator()(int timesteps, int simulations) const {
+std::tuple<double, double, ErrorData, ErrorData> LookbackFloatingStrikeOption::operator()(int timesteps, int simulations,
+                                                                                          PricingWorkspace &workspace) const {
   return this->price_floating_strike(
-      timesteps, simulations, &find_min, &find_max,
+      timesteps, simulations, workspace, &find_min, &find_max,
+      [this](double min, double s) -> double {
+        return this->pay_off.call(min, s);
+      },
+      [this](double max, double s) -> double {
+        return this->pay_off.put(max, s);
+      });
+}
+
+std::tuple<double, double, ErrorData, ErrorData> BermudanAsianFixedStrikeOption::operator()(int timesteps, int simulations,
+                                                                                            PricingWorkspace &workspace) const {
+  this->lsm.price(
+      this->mc, this->options_params, timesteps, simulations, workspace, &update_average, &update_average,
+      [this](double avg, double) -> double {
+        return this->pay_off.call(avg);
+      },
+      [this](double avg, double) -> double {
+        return this->pay_off.put(avg);
+      });
+
+  return compute_pricing_results(workspace.pay_offs_call(), workspace.pay_offs_put());
+}
+
+std::tuple<double, double, ErrorData, ErrorData> BermudanAsianFloatingStrikeOption::operator()(int timesteps, int simulations,
+                                                                                               PricingWorkspace &workspace) const {
+  this->lsm.price(
+      this->mc, this->options_params, timesteps, simulations, workspace, &update_average, &update_average,
+      [this](double avg, double s) -> double {
+        return this->pay_off.call(avg, s);
+      },
+      [this](double avg, double s) -> double {
+        return this->pay_off.put(avg, s);
+      });
+
+  return compute_pricing_results(workspace.pay_offs_call(), workspace.pay_offs_put());
+}
+
+std::tuple<double, double, ErrorData, ErrorData> BermudanLookbackFixedStrikeOption::operator()(int timesteps, int simulations,
+                                                                                               PricingWorkspace &workspace) const {
+  this->lsm.price(
+      this->mc, this->options_params, timesteps, simulations, workspace, &update_max, &update_min,
+      [this](double max, double) -> double {
+        return this->pay_off.call(max);
+      },
+      [this](double min, double) -> double {
+        return this->pay_off.put(min);
+      });
+
+  return compute_pricing_results(workspace.pay_offs_call(), workspace.pay_offs_put());
+}
+
+std::tuple<double, double, ErrorData, ErrorData> BermudanLookbackFloatingStrikeOption::operator()(int timesteps, int simulations,
+                                                                                                  PricingWorkspace &workspace) const {
+  this->lsm.price(
+      this->mc, this->options_params, timesteps, simulations, workspace, &update_min, &update_max,
+      [this](double min, double s) -> double {
+        return this->pay_off.call(min, s);
+      },
+      [this](double max, double s) -> double {
+        return this->pay_off.put(max, s);
+      });
+
+  return compute_pricing_results(workspace.pay_offs_call(), workspace.pay_offs_put());
+}
+
+std::tuple<double, double, ErrorData, ErrorData> BarrierAsianFixedStrikeOption::operator()(int timesteps, int simulations,
+                                                                                           PricingWorkspace &workspace) const {
+  return this->price_barrier(
+      timesteps, simulations, workspace, this->pay_off, &update_average, &update_average,
+      [this](double avg, double) -> double {
+        return this->pay_off.call(avg);
+      },
+      [this](double avg, double) -> double {
+        return this->pay_off.put(avg);
+      });
+}
+
+std::tuple<double, double, ErrorData, ErrorData> BarrierAsianFloatingStrikeOption::operator()(int timesteps, int simulations,
+                                                                                              PricingWorkspace &workspace) const {
+  return this->price_barrier(
+      timesteps, simulations, workspace, this->pay_off, &update_average, &update_average,
+      [this](double avg, double s) -> double {
+        return this->pay_off.call(avg, s);
+      },
+      [this](double avg, double s) -> double {
+        return this->pay_off.put(avg, s);
+      });
+}
+
+std::tuple<double, double, ErrorData, ErrorData> BarrierLookbackFixedStrikeOption::operator()(int timesteps, int simulations,
+                                                                                              PricingWorkspace &workspace) const {
+  return this->price_barrier(
+      timesteps, simulations, workspace, this->pay_off, &update_max, &update_min,
+      [this](double max, double) -> double {
+        return this->pay_off.call(max);
+      },
+      [this](double min, double) -> double {
+        return this->pay_off.put(min);
+      });
+}
+
+std::tuple<double, double, ErrorData, ErrorData> BarrierLookbackFloatingStrikeOption::operator()(int timesteps, int simulations,
+                                                                                                 PricingWorkspace &workspace) const {
+  return this->price_barrier(
+      timesteps, simulations, workspace, this->pay_off, &update_min, &update_max,
       [this](double min, double s) -> double {
-        return this->pay_off->call(min, s);
+        return this->pay_off.call(min, s);
       },
       [this](double max, double s) -> double {
-        return this->pay_off->put(max, s);
+        return this->pay_off.put(max, s);
       });
 }
\ No newline at end of file
@@ -1,14 +1,18 @@
 #ifndef OPTION_H
 #define OPTION_H
 
+#include "LongstaffSchwartz.hpp"
 #include "MonteCarlo.hpp"
+#include "PathCache.hpp"
 #include "PayOff.hpp"
+#include "PricingWorkspace.hpp"
 #include <functional>
-#include <memory>
+#include <tuple>
 #include <vector>
 
 const double CRITICAL_VALUE = 1.96;
 const int CONFIDENCE = 95;
+const int BARRIER_BATCH_SIZE = 1024;
 
 struct ErrorData {
     double standard_error;
@@ -31,81 +35,177 @@ std::ostream &operator<<(std::ostream &os, const OptionsParams &params);
 
 class Option {
   public:
-    Option(std::shared_ptr<MonteCarlo> mc, OptionsParams &options_params);
+    Option(MonteCarlo &mc, OptionsParams &options_params);
     virtual ~Option();
 
-    virtual std::tuple<double, double, ErrorData, ErrorData> operator()(int timesteps, int simulations) const = 0;
+    virtual std::tuple<double, double, ErrorData, ErrorData> operator()(int timesteps, int simulations,
+                                                                        PricingWorkspace &workspace) const = 0;
     virtual double discount(const double s) const;
     virtual double std_error(const std::vector<double> &prices) const;
+    virtual double std_error(const double variance, const int count) const;
+    // fixed and floating strike pricing reuse the paths stored in path_cache instead of drawing new ones, nullptr disables it
+    void set_path_cache(PathCache *path_cache);
+    bool has_path_cache() const;
+    MonteCarlo &generator() const;
 
   protected:
-    std::shared_ptr<MonteCarlo> mc;
+    MonteCarlo &mc;
     OptionsParams &options_params;
+    PathCache *path_cache;
     virtual std::tuple<double, double, ErrorData, ErrorData> compute_pricing_results(const std::vector<double> &pay_offs_call,
                                                                                      const std::vector<double> &pay_offs_put) const;
+    virtual std::tuple<double, double, ErrorData, ErrorData>
+    price_barrier(int timesteps, int simulations, PricingWorkspace &workspace, const PayOff &pay_off,
+                  double (*update_stat_call)(const double, const double, const int),
+                  double (*update_stat_put)(const double, const double, const int),
+                  std::function<double(const double, const double)> pay_off_func_call,
+                  std::function<double(const double, const double)> pay_off_func_put) const;
 };
 
 class FixedStrikeOption : public Option {
   public:
-    FixedStrikeOption(std::unique_ptr<PayOffFixedStrike> pay_off, std::shared_ptr<MonteCarlo> mc, OptionsParams &options_params);
+    FixedStrikeOption(PayOffFixedStrike &pay_off, MonteCarlo &mc, OptionsParams &options_params);
     virtual ~FixedStrikeOption();
 
-    virtual std::tuple<double, double, ErrorData, ErrorData> price_fixed_strike(int timesteps, int simulations,
+    virtual std::tuple<double, double, ErrorData, ErrorData> price_fixed_strike(int timesteps, int simulations, PricingWorkspace &workspace,
                                                                                 double (*stat_func_call)(const std::vector<double> &),
                                                                                 double (*stat_func_put)(const std::vector<double> &),
                                                                                 std::function<double(const double)> pay_off_func_call,
                                                                                 std::function<double(const double)> pay_off_func_put) const;
 
   protected:
-    std::unique_ptr<PayOffFixedStrike> pay_off;
+    const PayOffFixedStrike &pay_off;
 };
 
 class FloatingStrikeOption : public Option {
   public:
-    FloatingStrikeOption(std::unique_ptr<PayOffFloatingStrike> pay_off, std::shared_ptr<MonteCarlo> mc, OptionsParams &options_params);
+    FloatingStrikeOption(PayOffFloatingStrike &pay_off, MonteCarlo &mc, OptionsParams &options_params);
     virtual ~FloatingStrikeOption();
 
     virtual std::tuple<double, double, ErrorData, ErrorData>
-    price_floating_strike(int timesteps, int simulations, double (*stat_func_call)(const std::vector<double> &),
+    price_floating_strike(int timesteps, int simulations, PricingWorkspace &workspace,
+                          double (*stat_func_call)(const std::vector<double> &),
                           double (*stat_func_put)(const std::vector<double> &),
                           std::function<double(const double, const double)> call_pay_off_call,
                           std::function<double(const double, const double)> pay_off_func_put) const;
 
   protected:
-    std::unique_ptr<PayOffFloatingStrike> pay_off;
+    const PayOffFloatingStrike &pay_off;
 };
 
 class AsianFixedStrikeOption : public FixedStrikeOption {
   public:
-    AsianFixedStrikeOption(std::unique_ptr<PayOffFixedStrike> pay_off, std::shared_ptr<MonteCarlo> mc, OptionsParams &options_params);
+    AsianFixedStrikeOption(PayOffFixedStrike &pay_off, MonteCarlo &mc, OptionsParams &options_params);
     ~AsianFixedStrikeOption();
 
-    std::tuple<double, double, ErrorData, ErrorData> operator()(int timesteps, int simulations) const override;
+    std::tuple<double, double, ErrorData, ErrorData> operator()(int timesteps, int simulations, PricingWorkspace &workspace) const override;
 };
 
 class AsianFloatingStrikeOption : public FloatingStrikeOption {
   public:
-    AsianFloatingStrikeOption(std::unique_ptr<PayOffFloatingStrike> pay_off, std::shared_ptr<MonteCarlo> mc, OptionsParams &options_params);
+    AsianFloatingStrikeOption(PayOffFloatingStrike &pay_off, MonteCarlo &mc, OptionsParams &options_params);
     ~AsianFloatingStrikeOption();
 
-    std::tuple<double, double, ErrorData, ErrorData> operator()(int timesteps, int simulations) const override;
+    std::tuple<double, double, ErrorData, ErrorData> operator()(int timesteps, int simulations, PricingWorkspace &workspace) const override;
 };
 
 class LookbackFixedStrikeOption : public FixedStrikeOption {
   public:
-    LookbackFixedStrikeOption(std::unique_ptr<PayOffFixedStrike> pay_off, std::shared_ptr<MonteCarlo> mc, OptionsParams &options_params);
+    LookbackFixedStrikeOption(PayOffFixedStrike &pay_off, MonteCarlo &mc, OptionsParams &options_params);
     ~LookbackFixedStrikeOption();
 
-    std::tuple<double, double, ErrorData, ErrorData> operator()(int timesteps, int simulations) const override;
+    std::tuple<double, double, ErrorData, ErrorData> operator()(int timesteps, int simulations, PricingWorkspace &workspace) const override;
 };
 
 class LookbackFloatingStrikeOption : public FloatingStrikeOption {
   public:
-    LookbackFloatingStrikeOption(std::unique_ptr<PayOffFloatingStrike> pay_off, std::shared_ptr<MonteCarlo> mc,
-                                 OptionsParams &options_params);
+    LookbackFloatingStrikeOption(PayOffFloatingStrike &pay_off, MonteCarlo &mc, OptionsParams &options_params);
     ~LookbackFloatingStrikeOption();
 
-    std::tuple<double, double, ErrorData, ErrorData> operator()(int timesteps, int simulations) const override;
+    std::tuple<double, double, ErrorData, ErrorData> operator()(int timesteps, int simulations, PricingWorkspace &workspace) const override;
+};
+
+// Early exercise variants, priced with the Longstaff-Schwartz engine
+
+class BermudanAsianFixedStrikeOption : public FixedStrikeOption {
+  public:
+    BermudanAsianFixedStrikeOption(PayOffFixedStrike &pay_off, MonteCarlo &mc, OptionsParams &options_params, LongstaffSchwartz &lsm);
+    ~BermudanAsianFixedStrikeOption();
+
+    std::tuple<double, double, ErrorData, ErrorData> operator()(int timesteps, int simulations, PricingWorkspace &workspace) const override;
+
+  private:
+    LongstaffSchwartz &lsm;
+};
+
+class BermudanAsianFloatingStrikeOption : public FloatingStrikeOption {
+  public:
+    BermudanAsianFloatingStrikeOption(PayOffFloatingStrike &pay_off, MonteCarlo &mc, OptionsParams &options_params,
+                                      LongstaffSchwartz &lsm);
+    ~BermudanAsianFloatingStrikeOption();
+
+    std::tuple<double, double, ErrorData, ErrorData> operator()(int timesteps, int simulations, PricingWorkspace &workspace) const override;
+
+  private:
+    LongstaffSchwartz &lsm;
+};
+
+class BermudanLookbackFixedStrikeOption : public FixedStrikeOption {
+  public:
+    BermudanLookbackFixedStrikeOption(PayOffFixedStrike &pay_off, MonteCarlo &mc, OptionsParams &options_params,
+                                      LongstaffSchwartz &lsm);
+    ~BermudanLookbackFixedStrikeOption();
+
+    std::tuple<double, double, ErrorData, ErrorData> operator()(int timesteps, int simulations, PricingWorkspace &workspace) const override;
+
+  private:
+    LongstaffSchwartz &lsm;
+};
+
+class BermudanLookbackFloatingStrikeOption : public FloatingStrikeOption {
+  public:
+    BermudanLookbackFloatingStrikeOption(PayOffFloatingStrike &pay_off, MonteCarlo &mc, OptionsParams &options_params,
+                                         LongstaffSchwartz &lsm);
+    ~BermudanLookbackFloatingStrikeOption();
+
+    std::tuple<double, double, ErrorData, ErrorData> operator()(int timesteps, int simulations, PricingWorkspace &workspace) const override;
+
+  private:
+    LongstaffSchwartz &lsm;
+};
+
+// Knock-in and knock-out variants, the barrier being carried by the payoff
+
+class BarrierAsianFixedStrikeOption : public FixedStrikeOption {
+  public:
+    BarrierAsianFixedStrikeOption(PayOffFixedStrike &pay_off, MonteCarlo &mc, OptionsParams &options_params);
+    ~BarrierAsianFixedStrikeOption();
+
+    std::tuple<double, double, ErrorData, ErrorData> operator()(int timesteps, int simulations, PricingWorkspace &workspace) const override;
+};
+
+class BarrierAsianFloatingStrikeOption : public FloatingStrikeOption {
+  public:
+    BarrierAsianFloatingStrikeOption(PayOffFloatingStrike &pay_off, MonteCarlo &mc, OptionsParams &options_params);
+    ~BarrierAsianFloatingStrikeOption();
+
+    std::tuple<double, double, ErrorData, ErrorData> operator()(int timesteps, int simulations, PricingWorkspace &workspace) const override;
+};
+
+class BarrierLookbackFixedStrikeOption : public FixedStrikeOption {
+  public:
+    BarrierLookbackFixedStrikeOption(PayOffFixedStrike &pay_off, MonteCarlo &mc, OptionsParams &options_params);
+    ~BarrierLookbackFixedStrikeOption();
+
+    std::tuple<double, double, ErrorData, ErrorData> operator()(int timesteps, int simulations, PricingWorkspace &workspace) const override;
+};
+
+class BarrierLookbackFloatingStrikeOption : public FloatingStrikeOption {
+  public:
+    BarrierLookbackFloatingStrikeOption(PayOffFloatingStrike &pay_off, MonteCarlo &mc, OptionsParams &options_params);
+    ~BarrierLookbackFloatingStrikeOption();
+
+    std::tuple<double, double, ErrorData, ErrorData> operator()(int timesteps, int simulations, PricingWorkspace &workspace) const override;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "PathCache.hpp"
+#include "MonteCarlo.hpp"
+#include "Option.hpp"
+#include <stdexcept>
+#include <vector>
+
+PathCache::PathCache() : timesteps(0), simulations(0), S0(0.0), T(0.0), sigma(0.0), r(0.0), paths_valid(false) {}
+
+PathCache::~PathCache() {}
+
+bool PathCache::is_registered(double (*stat_func)(const std::vector<double> &)) const {
+  for (double (*registered)(const std::vector<double> &) : stat_funcs) {
+    if (registered == stat_func) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void PathCache::update(MonteCarlo &mc, const OptionsParams &options_params, int timesteps, int simulations,
+                       double (*stat_func_call)(const std::vector<double> &), double (*stat_func_put)(const std::vector<double> &),
+                       std::vector<double> &prices) {
+  bool grid_changed = timesteps != this->timesteps || simulations != this->simulations;
+  if (grid_changed) {
+    this->timesteps = timesteps;
+    this->simulations = simulations;
+    snapshot = mc;
+    paths_valid = false;
+  }
+
+  if (options_params.T != T || options_params.sigma != sigma || options_params.r != r) {
+    paths_valid = false;
+  }
+  for (double (*stat_func)(const std::vector<double> &) : {stat_func_call, stat_func_put}) {
+    if (!is_registered(stat_func)) {
+      stat_funcs.push_back(stat_func);
+      stat_values.emplace_back();
+      paths_valid = false;
+    }
+  }
+
+  if (grid_changed) {
+    rebuild_paths(mc, options_params, prices);
+  } else if (!paths_valid) {
+    MonteCarlo replay = snapshot;
+    rebuild_paths(replay, options_params, prices);
+  }
+}
+
+// draws the paths through mc with MonteCarlo::simulate_price_path so a first pricing through the cache matches an uncached one
+void PathCache::rebuild_paths(MonteCarlo &mc, const OptionsParams &options_params, std::vector<double> &prices) {
+  S0 = options_params.S0;
+  T = options_params.T;
+  sigma = options_params.sigma;
+  r = options_params.r;
+
+  finals.resize(simulations);
+  for (std::vector<double> &values : stat_values) {
+    values.resize(simulations);
+  }
+
+  for (int p = 0; p < simulations; ++p) {
+    mc.simulate_price_path(prices, S0, r, sigma, T);
+
+    for (size_t f = 0; f < stat_funcs.size(); ++f) {
+      stat_values[f][p] = stat_funcs[f](prices);
+    }
+    finals[p] = prices.back();
+  }
+
+  paths_valid = true;
+}
+
+const std::vector<double> &PathCache::stats(double (*stat_func)(const std::vector<double> &)) const {
+  for (size_t f = 0; f < stat_funcs.size(); ++f) {
+    if (stat_funcs[f] == stat_func) {
+      return stat_values[f];
+    }
+  }
+  throw std::invalid_argument("statistic is not cached");
+}
+
+const std::vector<double> &PathCache::final_spots() const {
+  return finals;
+}
+
+double PathCache::scale(const OptionsParams &options_params) const {
+  return options_params.S0 / S0;
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef PATHCACHE_H
+#define PATHCACHE_H
+
+#include "MonteCarlo.hpp"
+#include <vector>
+
+struct OptionsParams;
+
+// Keeps the per-path statistics of the last pricing so that repricing after a parameter change only redoes what the
+// change invalidates. Under GBM the path is proportional to S0 and the statistics used by the pricers (average, max, min,
+// final spot) scale with it, so S0 and E changes only re-evaluate payoffs. The normals themselves are not stored: T, sigma
+// and r changes redraw them from a snapshot of the generator taken when the timesteps x simulations grid last changed.
+class PathCache {
+  public:
+    PathCache();
+    ~PathCache();
+
+    void update(MonteCarlo &mc, const OptionsParams &options_params, int timesteps, int simulations,
+                double (*stat_func_call)(const std::vector<double> &), double (*stat_func_put)(const std::vector<double> &),
+                std::vector<double> &prices);
+    const std::vector<double> &stats(double (*stat_func)(const std::vector<double> &)) const;
+    const std::vector<double> &final_spots() const;
+    double scale(const OptionsParams &options_params) const;
+
+  private:
+    int timesteps;
+    int simulations;
+    double S0;
+    double T;
+    double sigma;
+    double r;
+    bool paths_valid;
+    // generator state before the current grid's normals were drawn
+    MonteCarlo snapshot;
+    std::vector<double (*)(const std::vector<double> &)> stat_funcs;
+    std::vector<std::vector<double>> stat_values;
+    std::vector<double> finals;
+
+    bool is_registered(double (*stat_func)(const std::vector<double> &)) const;
+    void rebuild_paths(MonteCarlo &mc, const OptionsParams &options_params, std::vector<double> &prices);
+};
+
+#endif
\ No newline at end of file
@@ -1,22 +1,65 @@
 #include "PayOff.hpp"
 #include <algorithm>
+#include <cmath>
+#include <stdexcept>
 
-PayOff::PayOff() {}
+PayOff::PayOff() : barrier_monitored(false), barrier{BarrierType::UpAndOut, 0.0} {}
+
+PayOff::PayOff(const Barrier &barrier) : barrier_monitored(true), barrier(barrier) {
+  // crossing probabilities work on log(level / s), NaN levels are rejected too
+  if (!(barrier.level > 0.0)) {
+    throw std::invalid_argument("barrier level must be positive");
+  }
+}
 
 PayOff::~PayOff() {}
 
+bool PayOff::has_barrier() const {
+  return this->barrier_monitored;
+}
+
+const Barrier &PayOff::get_barrier() const {
+  return this->barrier;
+}
+
+bool PayOff::is_knock_out() const {
+  return this->barrier.type == BarrierType::UpAndOut || this->barrier.type == BarrierType::DownAndOut;
+}
+
+bool PayOff::is_crossed(const double s) const {
+  if (this->barrier.type == BarrierType::UpAndOut || this->barrier.type == BarrierType::UpAndIn) {
+    return s >= this->barrier.level;
+  }
+  return s <= this->barrier.level;
+}
+
+// probability that the Brownian bridge between two monitoring points neither of which crossed the barrier
+// touches it in between
+double PayOff::crossing_probability(const double s_start, const double s_end, const double sigma, const double dt) const {
+  double distance_start = std::log(this->barrier.level / s_start);
+  double distance_end = std::log(this->barrier.level / s_end);
+
+  return std::exp(-2.0 * distance_start * distance_end / (sigma * sigma * dt));
+}
+
 PayOffFixedStrike::PayOffFixedStrike(double strike) : strike(strike) {}
 
+PayOffFixedStrike::PayOffFixedStrike(double strike, const Barrier &barrier) : PayOff(barrier), strike(strike) {}
+
 PayOffFixedStrike::~PayOffFixedStrike() {}
 
 PayOffFloatingStrike::PayOffFloatingStrike() {}
 
+PayOffFloatingStrike::PayOffFloatingStrike(const Barrier &barrier) : PayOff(barrier) {}
+
 PayOffFloatingStrike::~PayOffFloatingStrike() {}
 
 // Asian payoffs
 
 AsianFixedStrikePayOff::AsianFixedStrikePayOff(double strike) : PayOffFixedStrike(strike) {}
 
+AsianFixedStrikePayOff::AsianFixedStrikePayOff(double strike, const Barrier &barrier) : PayOffFixedStrike(strike, barrier) {}
+
 AsianFixedStrikePayOff::~AsianFixedStrikePayOff() {}
 
 double AsianFixedStrikePayOff::call(const double avg) const {
@@ -29,6 +72,8 @@ double AsianFixedStrikePayOff::put(const double avg) const {
 
 AsianFloatingStrikePayOff::AsianFloatingStrikePayOff() {}
 
+AsianFloatingStrikePayOff::AsianFloatingStrikePayOff(const Barrier &barrier) : PayOffFloatingStrike(barrier) {}
+
 AsianFloatingStrikePayOff::~AsianFloatingStrikePayOff() {}
 
 double AsianFloatingStrikePayOff::call(const double avg, const double s) const {
@@ -43,6 +88,8 @@ double AsianFloatingStrikePayOff::put(const double avg, const double s) const {
 
 LookbackFixedStrikePayOff::LookbackFixedStrikePayOff(double strike) : PayOffFixedStrike(strike) {}
 
+LookbackFixedStrikePayOff::LookbackFixedStrikePayOff(double strike, const Barrier &barrier) : PayOffFixedStrike(strike, barrier) {}
+
 LookbackFixedStrikePayOff::~LookbackFixedStrikePayOff() {}
 
 double LookbackFixedStrikePayOff::call(const double max) const {
@@ -55,6 +102,8 @@ double LookbackFixedStrikePayOff::put(const double min) const {
 
 LookbackFloatingStrikePayOff::LookbackFloatingStrikePayOff() {}
 
+LookbackFloatingStrikePayOff::LookbackFloatingStrikePayOff(const Barrier &barrier) : PayOffFloatingStrike(barrier) {}
+
 LookbackFloatingStrikePayOff::~LookbackFloatingStrikePayOff() {}
 
 double LookbackFloatingStrikePayOff::call(const double min, const double s) const {
@@ -1,15 +1,34 @@
 #ifndef PAYOFF_H
 #define PAYOFF_H
 
+enum class BarrierType { UpAndOut, DownAndOut, UpAndIn, DownAndIn };
+
+struct Barrier {
+    BarrierType type;
+    double level;
+};
+
 class PayOff {
   public:
     PayOff();
+    PayOff(const Barrier &barrier);
     virtual ~PayOff();
+
+    bool has_barrier() const;
+    const Barrier &get_barrier() const;
+    bool is_knock_out() const;
+    bool is_crossed(const double s) const;
+    double crossing_probability(const double s_start, const double s_end, const double sigma, const double dt) const;
+
+  protected:
+    bool barrier_monitored;
+    Barrier barrier;
 };
 
 class PayOffFixedStrike : public PayOff {
   public:
     PayOffFixedStrike(double strike);
+    PayOffFixedStrike(double strike, const Barrier &barrier);
     virtual ~PayOffFixedStrike();
 
     virtual double call(const double stat) const = 0;
@@ -22,6 +41,7 @@ class PayOffFixedStrike : public PayOff {
 class PayOffFloatingStrike : public PayOff {
   public:
     PayOffFloatingStrike();
+    PayOffFloatingStrike(const Barrier &barrier);
     virtual ~PayOffFloatingStrike();
 
     virtual double call(const double stat, const double s) const = 0;
@@ -31,6 +51,7 @@ class PayOffFloatingStrike : public PayOff {
 class AsianFixedStrikePayOff : public PayOffFixedStrike {
   public:
     AsianFixedStrikePayOff(double strike);
+    AsianFixedStrikePayOff(double strike, const Barrier &barrier);
     ~AsianFixedStrikePayOff();
 
     double call(const double avg) const override;
@@ -40,6 +61,7 @@ class AsianFixedStrikePayOff : public PayOffFixedStrike {
 class AsianFloatingStrikePayOff : public PayOffFloatingStrike {
   public:
     AsianFloatingStrikePayOff();
+    AsianFloatingStrikePayOff(const Barrier &barrier);
     ~AsianFloatingStrikePayOff();
 
     double call(const double avg, const double s) const override;
@@ -49,6 +71,7 @@ class AsianFloatingStrikePayOff : public PayOffFloatingStrike {
 class LookbackFixedStrikePayOff : public PayOffFixedStrike {
   public:
     LookbackFixedStrikePayOff(double strike);
+    LookbackFixedStrikePayOff(double strike, const Barrier &barrier);
     ~LookbackFixedStrikePayOff();
 
     double call(const double max) const override;
@@ -58,6 +81,7 @@ class LookbackFixedStrikePayOff : public PayOffFixedStrike {
 class LookbackFloatingStrikePayOff : public PayOffFloatingStrike {
   public:
     LookbackFloatingStrikePayOff();
+    LookbackFloatingStrikePayOff(const Barrier &barrier);
     ~LookbackFloatingStrikePayOff();
 
     double call(const double min, const double s) const override;
@@ -0,0 +1,66 @@
+#include "PricingWorkspace.hpp"
+#include <stdexcept>
+#include <vector>
+
+PricingWorkspace::PricingWorkspace() {}
+
+PricingWorkspace::PricingWorkspace(int timesteps, int simulations) {
+  reserve(timesteps, simulations);
+}
+
+PricingWorkspace::~PricingWorkspace() {}
+
+void PricingWorkspace::reserve(int timesteps, int simulations) {
+  if (timesteps <= 0 || simulations <= 0) {
+    throw std::invalid_argument("timesteps and simulations must be positive");
+  }
+
+  // shrinking a vector keeps its capacity, so switching back to a larger shape that was already seen does not allocate
+  path_buffer.resize(timesteps);
+  pay_offs_call_buffer.resize(simulations);
+  pay_offs_put_buffer.resize(simulations);
+}
+
+void PricingWorkspace::reserve_lanes(int lanes) {
+  if (lanes <= 0) {
+    throw std::invalid_argument("lanes must be positive");
+  }
+
+  lane_spots_buffer.resize(lanes);
+  lane_stats_call_buffer.resize(lanes);
+  lane_stats_put_buffer.resize(lanes);
+  lane_survival_buffer.resize(lanes);
+  lane_paths_buffer.resize(lanes);
+}
+
+std::vector<double> &PricingWorkspace::path() {
+  return path_buffer;
+}
+
+std::vector<double> &PricingWorkspace::pay_offs_call() {
+  return pay_offs_call_buffer;
+}
+
+std::vector<double> &PricingWorkspace::pay_offs_put() {
+  return pay_offs_put_buffer;
+}
+
+std::vector<double> &PricingWorkspace::lane_spots() {
+  return lane_spots_buffer;
+}
+
+std::vector<double> &PricingWorkspace::lane_stats_call() {
+  return lane_stats_call_buffer;
+}
+
+std::vector<double> &PricingWorkspace::lane_stats_put() {
+  return lane_stats_put_buffer;
+}
+
+std::vector<double> &PricingWorkspace::lane_survival() {
+  return lane_survival_buffer;
+}
+
+std::vector<int> &PricingWorkspace::lane_paths() {
+  return lane_paths_buffer;
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef PRICINGWORKSPACE_H
+#define PRICINGWORKSPACE_H
+
+#include <vector>
+
+// Scratch buffers shared by repeated pricings. Buffers are only grown, never released, so pricing the
+// same timesteps x simulations shape again performs no heap allocation once the workspace is warm.
+class PricingWorkspace {
+  public:
+    PricingWorkspace();
+    PricingWorkspace(int timesteps, int simulations);
+    ~PricingWorkspace();
+
+    void reserve(int timesteps, int simulations);
+    void reserve_lanes(int lanes);
+
+    std::vector<double> &path();
+    std::vector<double> &pay_offs_call();
+    std::vector<double> &pay_offs_put();
+
+    // per lane state of the batched path engine, lanes being compacted as paths terminate
+    std::vector<double> &lane_spots();
+    std::vector<double> &lane_stats_call();
+    std::vector<double> &lane_stats_put();
+    std::vector<double> &lane_survival();
+    std::vector<int> &lane_paths();
+
+  private:
+    std::vector<double> path_buffer;
+    std::vector<double> pay_offs_call_buffer;
+    std::vector<double> pay_offs_put_buffer;
+    std::vector<double> lane_spots_buffer;
+    std::vector<double> lane_stats_call_buffer;
+    std::vector<double> lane_stats_put_buffer;
+    std::vector<double> lane_survival_buffer;
+    std::vector<int> lane_paths_buffer;
+};
+
+#endif
\ No newline at end of file
@@ -1,12 +1,21 @@
 #include "Simulation.hpp"
+#include "DistributedPricer.hpp"
+#include "LongstaffSchwartz.hpp"
 #include "MonteCarlo.hpp"
 #include "Option.hpp"
+#include "PathCache.hpp"
+#include "PayOff.hpp"
+#include "PricingWorkspace.hpp"
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <thread>
 #include <tuple>
 
 Simulation::Simulation(std::string name, int timesteps, int simulations, std::shared_ptr<MonteCarlo> mc, OptionsParams params)
-    : name(name), timesteps(timesteps), nb_simulations(simulations), price_call(0.0), price_put(0.0), option_params(params), mc(mc) {}
+    : name(name), timesteps(timesteps), nb_simulations(simulations), workers(1), price_call(0.0), price_put(0.0), option_params(params),
+      barrier{BarrierType::UpAndOut, std::numeric_limits<double>::infinity()}, mc(mc), workspace(timesteps, simulations) {}
 
 Simulation::~Simulation() {}
 
@@ -19,6 +28,14 @@ std::ostream &operator<<(std::ostream &os, const Simulation &simulation) {
   return os;
 }
 
+LongstaffSchwartz &Simulation::longstaff_schwartz() {
+  if (!lsm) {
+    int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    lsm = std::make_unique<LongstaffSchwartz>(EXERCISE_DATES, nb_simulations, threads);
+  }
+  return *lsm;
+}
+
 void Simulation::change_S0(double S0) {
   option_params.S0 = S0;
 }
@@ -39,6 +56,14 @@ void Simulation::change_r(double r) {
   option_params.r = r;
 }
 
+void Simulation::change_barrier(const Barrier &barrier) {
+  this->barrier = barrier;
+}
+
+void Simulation::change_workers(int workers) {
+  this->workers = workers;
+}
+
 void Simulation::fill_price_data(const std::tuple<double, double, ErrorData, ErrorData> &result) {
   price_call = std::get<0>(result);
   price_put = std::get<1>(result);
@@ -55,37 +80,141 @@ void Simulation::reset_params(const OptionsParams &params) {
 }
 
 void Simulation::simulate_asian_option_fixed_strike() {
-  std::unique_ptr<PayOffFixedStrike> asian_fixed_strike_pay_off = std::make_unique<AsianFixedStrikePayOff>(option_params.E);
-  std::unique_ptr<Option> asian_fixed_strike_option =
-      std::make_unique<AsianFixedStrikeOption>(std::move(asian_fixed_strike_pay_off), mc, option_params);
+  AsianFixedStrikePayOff asian_fixed_strike_pay_off(option_params.E);
+  AsianFixedStrikeOption asian_fixed_strike_option(asian_fixed_strike_pay_off, *mc, option_params);
+  asian_fixed_strike_option.set_path_cache(&path_cache);
 
-  std::tuple<double, double, ErrorData, ErrorData> prices = (*asian_fixed_strike_option)(timesteps, nb_simulations);
+  std::tuple<double, double, ErrorData, ErrorData> prices = asian_fixed_strike_option(timesteps, nb_simulations, workspace);
   fill_price_data(prices);
 }
 
 void Simulation::simulate_asian_option_floating_strike() {
-  std::unique_ptr<PayOffFloatingStrike> asian_floating_strike_pay_off = std::make_unique<AsianFloatingStrikePayOff>();
-  std::unique_ptr<Option> asian_floating_strike_option =
-      std::make_unique<AsianFloatingStrikeOption>(std::move(asian_floating_strike_pay_off), mc, option_params);
+  AsianFloatingStrikePayOff asian_floating_strike_pay_off;
+  AsianFloatingStrikeOption asian_floating_strike_option(asian_floating_strike_pay_off, *mc, option_params);
+  asian_floating_strike_option.set_path_cache(&path_cache);
 
-  std::tuple<double, double, ErrorData, ErrorData> prices = (*asian_floating_strike_option)(timesteps, nb_simulations);
+  std::tuple<double, double, ErrorData, ErrorData> prices = asian_floating_strike_option(timesteps, nb_simulations, workspace);
   fill_price_data(prices);
 }
 
 void Simulation::simulate_lookback_option_fixed_strike() {
-  std::unique_ptr<PayOffFixedStrike> lookback_fixed_strike_pay_off = std::make_unique<LookbackFixedStrikePayOff>(option_params.E);
-  std::unique_ptr<Option> lookback_fixed_strike_option =
-      std::make_unique<LookbackFixedStrikeOption>(std::move(lookback_fixed_strike_pay_off), mc, option_params);
+  LookbackFixedStrikePayOff lookback_fixed_strike_pay_off(option_params.E);
+  LookbackFixedStrikeOption lookback_fixed_strike_option(lookback_fixed_strike_pay_off, *mc, option_params);
+  lookback_fixed_strike_option.set_path_cache(&path_cache);
 
-  std::tuple<double, double, ErrorData, ErrorData> prices = (*lookback_fixed_strike_option)(timesteps, nb_simulations);
+  std::tuple<double, double, ErrorData, ErrorData> prices = lookback_fixed_strike_option(timesteps, nb_simulations, workspace);
   fill_price_data(prices);
 }
 
 void Simulation::simulate_lookback_option_floating_strike() {
-  std::unique_ptr<PayOffFloatingStrike> lookback_floating_strike_pay_off = std::make_unique<LookbackFloatingStrikePayOff>();
-  std::unique_ptr<Option> lookback_floating_strike_option =
-      std::make_unique<LookbackFloatingStrikeOption>(std::move(lookback_floating_strike_pay_off), mc, option_params);
+  LookbackFloatingStrikePayOff lookback_floating_strike_pay_off;
+  LookbackFloatingStrikeOption lookback_floating_strike_option(lookback_floating_strike_pay_off, *mc, option_params);
+  lookback_floating_strike_option.set_path_cache(&path_cache);
+
+  std::tuple<double, double, ErrorData, ErrorData> prices = lookback_floating_strike_option(timesteps, nb_simulations, workspace);
+  fill_price_data(prices);
+}
+
+void Simulation::simulate_bermudan_asian_option_fixed_strike() {
+  AsianFixedStrikePayOff bermudan_asian_fixed_strike_pay_off(option_params.E);
+  BermudanAsianFixedStrikeOption bermudan_asian_fixed_strike_option(bermudan_asian_fixed_strike_pay_off, *mc, option_params,
+                                                                    longstaff_schwartz());
+
+  std::tuple<double, double, ErrorData, ErrorData> prices = bermudan_asian_fixed_strike_option(timesteps, nb_simulations, workspace);
+  fill_price_data(prices);
+}
+
+void Simulation::simulate_bermudan_asian_option_floating_strike() {
+  AsianFloatingStrikePayOff bermudan_asian_floating_strike_pay_off;
+  BermudanAsianFloatingStrikeOption bermudan_asian_floating_strike_option(bermudan_asian_floating_strike_pay_off, *mc, option_params,
+                                                                          longstaff_schwartz());
+
+  std::tuple<double, double, ErrorData, ErrorData> prices = bermudan_asian_floating_strike_option(timesteps, nb_simulations, workspace);
+  fill_price_data(prices);
+}
+
+void Simulation::simulate_bermudan_lookback_option_fixed_strike() {
+  LookbackFixedStrikePayOff bermudan_lookback_fixed_strike_pay_off(option_params.E);
+  BermudanLookbackFixedStrikeOption bermudan_lookback_fixed_strike_option(bermudan_lookback_fixed_strike_pay_off, *mc, option_params,
+                                                                          longstaff_schwartz());
+
+  std::tuple<double, double, ErrorData, ErrorData> prices = bermudan_lookback_fixed_strike_option(timesteps, nb_simulations, workspace);
+  fill_price_data(prices);
+}
+
+void Simulation::simulate_bermudan_lookback_option_floating_strike() {
+  LookbackFloatingStrikePayOff bermudan_lookback_floating_strike_pay_off;
+  BermudanLookbackFloatingStrikeOption bermudan_lookback_floating_strike_option(bermudan_lookback_floating_strike_pay_off, *mc,
+                                                                                option_params, longstaff_schwartz());
+
+  std::tuple<double, double, ErrorData, ErrorData> prices = bermudan_lookback_floating_strike_option(timesteps, nb_simulations, workspace);
+  fill_price_data(prices);
+}
+
+void Simulation::simulate_barrier_asian_option_fixed_strike() {
+  AsianFixedStrikePayOff barrier_asian_fixed_strike_pay_off(option_params.E, barrier);
+  BarrierAsianFixedStrikeOption barrier_asian_fixed_strike_option(barrier_asian_fixed_strike_pay_off, *mc, option_params);
+
+  std::tuple<double, double, ErrorData, ErrorData> prices = barrier_asian_fixed_strike_option(timesteps, nb_simulations, workspace);
+  fill_price_data(prices);
+}
+
+void Simulation::simulate_barrier_asian_option_floating_strike() {
+  AsianFloatingStrikePayOff barrier_asian_floating_strike_pay_off(barrier);
+  BarrierAsianFloatingStrikeOption barrier_asian_floating_strike_option(barrier_asian_floating_strike_pay_off, *mc, option_params);
+
+  std::tuple<double, double, ErrorData, ErrorData> prices = barrier_asian_floating_strike_option(timesteps, nb_simulations, workspace);
+  fill_price_data(prices);
+}
+
+void Simulation::simulate_barrier_lookback_option_fixed_strike() {
+  LookbackFixedStrikePayOff barrier_lookback_fixed_strike_pay_off(option_params.E, barrier);
+  BarrierLookbackFixedStrikeOption barrier_lookback_fixed_strike_option(barrier_lookback_fixed_strike_pay_off, *mc, option_params);
+
+  std::tuple<double, double, ErrorData, ErrorData> prices = barrier_lookback_fixed_strike_option(timesteps, nb_simulations, workspace);
+  fill_price_data(prices);
+}
+
+void Simulation::simulate_barrier_lookback_option_floating_strike() {
+  LookbackFloatingStrikePayOff barrier_lookback_floating_strike_pay_off(barrier);
+  BarrierLookbackFloatingStrikeOption barrier_lookback_floating_strike_option(barrier_lookback_floating_strike_pay_off, *mc, option_params);
+
+  std::tuple<double, double, ErrorData, ErrorData> prices = barrier_lookback_floating_strike_option(timesteps, nb_simulations, workspace);
+  fill_price_data(prices);
+}
+
+void Simulation::simulate_distributed_asian_option_fixed_strike() {
+  AsianFixedStrikePayOff asian_fixed_strike_pay_off(option_params.E);
+  AsianFixedStrikeOption asian_fixed_strike_option(asian_fixed_strike_pay_off, *mc, option_params);
+  DistributedPricer pricer(workers, DISTRIBUTED_SEED);
+
+  std::tuple<double, double, ErrorData, ErrorData> prices = pricer(asian_fixed_strike_option, timesteps, nb_simulations, workspace);
+  fill_price_data(prices);
+}
+
+void Simulation::simulate_distributed_asian_option_floating_strike() {
+  AsianFloatingStrikePayOff asian_floating_strike_pay_off;
+  AsianFloatingStrikeOption asian_floating_strike_option(asian_floating_strike_pay_off, *mc, option_params);
+  DistributedPricer pricer(workers, DISTRIBUTED_SEED);
+
+  std::tuple<double, double, ErrorData, ErrorData> prices = pricer(asian_floating_strike_option, timesteps, nb_simulations, workspace);
+  fill_price_data(prices);
+}
+
+void Simulation::simulate_distributed_lookback_option_fixed_strike() {
+  LookbackFixedStrikePayOff lookback_fixed_strike_pay_off(option_params.E);
+  LookbackFixedStrikeOption lookback_fixed_strike_option(lookback_fixed_strike_pay_off, *mc, option_params);
+  DistributedPricer pricer(workers, DISTRIBUTED_SEED);
+
+  std::tuple<double, double, ErrorData, ErrorData> prices = pricer(lookback_fixed_strike_option, timesteps, nb_simulations, workspace);
+  fill_price_data(prices);
+}
+
+void Simulation::simulate_distributed_lookback_option_floating_strike() {
+  LookbackFloatingStrikePayOff lookback_floating_strike_pay_off;
+  LookbackFloatingStrikeOption lookback_floating_strike_option(lookback_floating_strike_pay_off, *mc, option_params);
+  DistributedPricer pricer(workers, DISTRIBUTED_SEED);
 
-  std::tuple<double, double, ErrorData, ErrorData> prices = (*lookback_floating_strike_option)(timesteps, nb_simulations);
+  std::tuple<double, double, ErrorData, ErrorData> prices = pricer(lookback_floating_strike_option, timesteps, nb_simulations, workspace);
   fill_price_data(prices);
 }
\ No newline at end of file
@@ -1,8 +1,13 @@
 #ifndef SIMULATION_H
 #define SIMULATION_H
 
+#include "DistributedPricer.hpp"
+#include "LongstaffSchwartz.hpp"
 #include "MonteCarlo.hpp"
 #include "Option.hpp"
+#include "PathCache.hpp"
+#include "PayOff.hpp"
+#include "PricingWorkspace.hpp"
 #include <memory>
 #include <ostream>
 #include <string>
@@ -17,6 +22,8 @@ class Simulation {
     void change_E(double E);
     void change_sigma(double sigma);
     void change_r(double r);
+    void change_barrier(const Barrier &barrier);
+    void change_workers(int workers);
     void reset_params(const OptionsParams &params);
 
     friend std::ostream &operator<<(std::ostream &os, const Simulation &simulation);
@@ -25,17 +32,37 @@ class Simulation {
     void simulate_asian_option_floating_strike();
     void simulate_lookback_option_fixed_strike();
     void simulate_lookback_option_floating_strike();
+    void simulate_bermudan_asian_option_fixed_strike();
+    void simulate_bermudan_asian_option_floating_strike();
+    void simulate_bermudan_lookback_option_fixed_strike();
+    void simulate_bermudan_lookback_option_floating_strike();
+    void simulate_barrier_asian_option_fixed_strike();
+    void simulate_barrier_asian_option_floating_strike();
+    void simulate_barrier_lookback_option_fixed_strike();
+    void simulate_barrier_lookback_option_floating_strike();
+    void simulate_distributed_asian_option_fixed_strike();
+    void simulate_distributed_asian_option_floating_strike();
+    void simulate_distributed_lookback_option_fixed_strike();
+    void simulate_distributed_lookback_option_floating_strike();
 
   private:
     std::string name;
     OptionsParams option_params;
+    Barrier barrier;
     int timesteps;
     int nb_simulations;
+    int workers;
     double price_call;
     double price_put;
     ErrorData err_call;
     ErrorData err_put;
     std::shared_ptr<MonteCarlo> mc;
+    PricingWorkspace workspace;
+    PathCache path_cache;
+    // only started by the first Bermudan pricing, its worker threads are not needed by the other products
+    std::unique_ptr<LongstaffSchwartz> lsm;
+
+    LongstaffSchwartz &longstaff_schwartz();
 };
 
 #endif
\ No newline at end of file
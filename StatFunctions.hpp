@@ -45,4 +45,18 @@ inline double find_min(const std::vector<double> &prices) {
   return *std::min_element(prices.begin(), prices.end());
 }
 
+// running versions of the statistics above, n being the number of prices seen including s
+
+inline double update_average(const double avg, const double s, const int n) {
+  return avg + (s - avg) / n;
+}
+
+inline double update_max(const double max, const double s, const int) {
+  return std::max(max, s);
+}
+
+inline double update_min(const double min, const double s, const int) {
+  return std::min(min, s);
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,142 @@
+// Checks that repricing the same shape performs no heap allocation once the workspace is warm, whether the European
+// pricers go through the path cache with only payoffs re-evaluated (S0), through it with paths rebuilt (T, sigma), or
+// bypass it.
+// Build it with every translation unit except main.cpp:
+//   g++ -std=c++17 -O2 -pthread allocation_test.cpp MonteCarlo.cpp Option.cpp PayOff.cpp PricingWorkspace.cpp Simulation.cpp
+//       LongstaffSchwartz.cpp DistributedPricer.cpp PathCache.cpp -o allocation_test
+
+#include "MonteCarlo.hpp"
+#include "Option.hpp"
+#include "PayOff.hpp"
+#include "PricingWorkspace.hpp"
+#include "Simulation.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+
+const int SIMULATIONS = 2000;
+const int TIMESTEPS = 252;
+const int REPRICINGS = 5;
+const OptionsParams INITIAL_OTION_PARAMETERS = {100.0, 100.0, 1.0, 0.2, 0.05};
+
+// the Longstaff-Schwartz workers run on other threads, so the counter has to be atomic
+static std::atomic<long> allocations{0};
+
+void *operator new(std::size_t size) {
+  ++allocations;
+  if (void *p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+  std::free(p);
+}
+
+bool report(const std::string &name, long count) {
+  std::cout << (count == 0 ? "PASS " : "FAIL ") << name << ": " << count << " allocations after warm-up" << std::endl;
+  return count == 0;
+}
+
+// prices once to warm the workspace, then counts allocations across repricings that each move one parameter by step
+bool check_no_allocations(const std::string &name, Simulation &simulator, void (Simulation::*func)(),
+                          void (Simulation::*change)(double), double first, double step) {
+  simulator.reset_params(INITIAL_OTION_PARAMETERS);
+  (simulator.*func)();
+
+  long before = allocations.load();
+  for (int i = 1; i <= REPRICINGS; ++i) {
+    (simulator.*change)(first + i * step);
+    (simulator.*func)();
+  }
+  return report(name, allocations.load() - before);
+}
+
+// same check for an option built without a path cache, so every repricing simulates its paths
+bool check_no_allocations(const std::string &name, const Option &option, OptionsParams &options_params) {
+  PricingWorkspace workspace;
+  options_params = INITIAL_OTION_PARAMETERS;
+  option(TIMESTEPS, SIMULATIONS, workspace);
+
+  long before = allocations.load();
+  for (int i = 1; i <= REPRICINGS; ++i) {
+    options_params.S0 = INITIAL_OTION_PARAMETERS.S0 + i;
+    option(TIMESTEPS, SIMULATIONS, workspace);
+  }
+  return report(name, allocations.load() - before);
+}
+
+// the distributed pricer is left out: forking workers allocates by design
+int main() {
+  std::shared_ptr<MonteCarlo> mc = std::make_shared<MonteCarlo>();
+  Simulation simulator("Allocation test", TIMESTEPS, SIMULATIONS, mc, INITIAL_OTION_PARAMETERS);
+  simulator.change_barrier({BarrierType::UpAndOut, 120.0});
+  bool ok = true;
+
+  ok &= check_no_allocations("Asian fixed strike", simulator, &Simulation::simulate_asian_option_fixed_strike,
+                             &Simulation::change_S0, INITIAL_OTION_PARAMETERS.S0, 1.0);
+  ok &= check_no_allocations("Asian fixed strike after a T change", simulator, &Simulation::simulate_asian_option_fixed_strike,
+                             &Simulation::change_T, INITIAL_OTION_PARAMETERS.T, 0.1);
+  ok &= check_no_allocations("Asian fixed strike after a sigma change", simulator, &Simulation::simulate_asian_option_fixed_strike,
+                             &Simulation::change_sigma, INITIAL_OTION_PARAMETERS.sigma, 0.01);
+  ok &= check_no_allocations("Asian floating strike", simulator, &Simulation::simulate_asian_option_floating_strike,
+                             &Simulation::change_S0, INITIAL_OTION_PARAMETERS.S0, 1.0);
+  ok &= check_no_allocations("Asian floating strike after a T change", simulator, &Simulation::simulate_asian_option_floating_strike,
+                             &Simulation::change_T, INITIAL_OTION_PARAMETERS.T, 0.1);
+  ok &= check_no_allocations("Asian floating strike after a sigma change", simulator, &Simulation::simulate_asian_option_floating_strike,
+                             &Simulation::change_sigma, INITIAL_OTION_PARAMETERS.sigma, 0.01);
+  ok &= check_no_allocations("Lookback fixed strike", simulator, &Simulation::simulate_lookback_option_fixed_strike,
+                             &Simulation::change_S0, INITIAL_OTION_PARAMETERS.S0, 1.0);
+  ok &= check_no_allocations("Lookback fixed strike after a T change", simulator, &Simulation::simulate_lookback_option_fixed_strike,
+                             &Simulation::change_T, INITIAL_OTION_PARAMETERS.T, 0.1);
+  ok &= check_no_allocations("Lookback fixed strike after a sigma change", simulator, &Simulation::simulate_lookback_option_fixed_strike,
+                             &Simulation::change_sigma, INITIAL_OTION_PARAMETERS.sigma, 0.01);
+  ok &= check_no_allocations("Lookback floating strike", simulator, &Simulation::simulate_lookback_option_floating_strike,
+                             &Simulation::change_S0, INITIAL_OTION_PARAMETERS.S0, 1.0);
+  ok &= check_no_allocations("Lookback floating strike after a T change", simulator, &Simulation::simulate_lookback_option_floating_strike,
+                             &Simulation::change_T, INITIAL_OTION_PARAMETERS.T, 0.1);
+  ok &= check_no_allocations("Lookback floating strike after a sigma change", simulator,
+                             &Simulation::simulate_lookback_option_floating_strike,
+                             &Simulation::change_sigma, INITIAL_OTION_PARAMETERS.sigma, 0.01);
+  ok &= check_no_allocations("Bermudan Asian fixed strike", simulator, &Simulation::simulate_bermudan_asian_option_fixed_strike,
+                             &Simulation::change_S0, INITIAL_OTION_PARAMETERS.S0, 1.0);
+  ok &= check_no_allocations("Bermudan Asian floating strike", simulator, &Simulation::simulate_bermudan_asian_option_floating_strike,
+                             &Simulation::change_S0, INITIAL_OTION_PARAMETERS.S0, 1.0);
+  ok &= check_no_allocations("Bermudan lookback fixed strike", simulator, &Simulation::simulate_bermudan_lookback_option_fixed_strike,
+                             &Simulation::change_S0, INITIAL_OTION_PARAMETERS.S0, 1.0);
+  ok &= check_no_allocations("Bermudan lookback floating strike", simulator, &Simulation::simulate_bermudan_lookback_option_floating_strike,
+                             &Simulation::change_S0, INITIAL_OTION_PARAMETERS.S0, 1.0);
+  ok &= check_no_allocations("Barrier Asian fixed strike", simulator, &Simulation::simulate_barrier_asian_option_fixed_strike,
+                             &Simulation::change_S0, INITIAL_OTION_PARAMETERS.S0, 1.0);
+  ok &= check_no_allocations("Barrier Asian floating strike", simulator, &Simulation::simulate_barrier_asian_option_floating_strike,
+                             &Simulation::change_S0, INITIAL_OTION_PARAMETERS.S0, 1.0);
+  ok &= check_no_allocations("Barrier lookback fixed strike", simulator, &Simulation::simulate_barrier_lookback_option_fixed_strike,
+                             &Simulation::change_S0, INITIAL_OTION_PARAMETERS.S0, 1.0);
+  ok &= check_no_allocations("Barrier lookback floating strike", simulator, &Simulation::simulate_barrier_lookback_option_floating_strike,
+                             &Simulation::change_S0, INITIAL_OTION_PARAMETERS.S0, 1.0);
+
+  MonteCarlo uncached_mc;
+  OptionsParams uncached_params = INITIAL_OTION_PARAMETERS;
+  AsianFixedStrikePayOff asian_fixed_strike_pay_off(INITIAL_OTION_PARAMETERS.E);
+  AsianFloatingStrikePayOff asian_floating_strike_pay_off;
+  LookbackFixedStrikePayOff lookback_fixed_strike_pay_off(INITIAL_OTION_PARAMETERS.E);
+  LookbackFloatingStrikePayOff lookback_floating_strike_pay_off;
+  ok &= check_no_allocations("Uncached Asian fixed strike",
+                             AsianFixedStrikeOption(asian_fixed_strike_pay_off, uncached_mc, uncached_params), uncached_params);
+  ok &= check_no_allocations("Uncached Asian floating strike",
+                             AsianFloatingStrikeOption(asian_floating_strike_pay_off, uncached_mc, uncached_params), uncached_params);
+  ok &= check_no_allocations("Uncached lookback fixed strike",
+                             LookbackFixedStrikeOption(lookback_fixed_strike_pay_off, uncached_mc, uncached_params), uncached_params);
+  ok &= check_no_allocations("Uncached lookback floating strike",
+                             LookbackFloatingStrikeOption(lookback_floating_strike_pay_off, uncached_mc, uncached_params), uncached_params);
+
+  return ok ? 0 : 1;
+}
\ No newline at end of file
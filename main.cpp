@@ -1,5 +1,6 @@
 #include "MonteCarlo.hpp"
 #include "Option.hpp"
+#include "PayOff.hpp"
 #include "Simulation.hpp"
 #include <iostream>
 #include <memory>
@@ -7,6 +8,9 @@
 const int SIMULATIONS = 10000;
 const int TIMESTEPS = 252;
 const OptionsParams INITIAL_OTION_PARAMETERS = {100.0, 100.0, 1.0, 0.2, 0.05};
+const Barrier UP_AND_OUT_BARRIER = {BarrierType::UpAndOut, 120.0};
+const Barrier DOWN_AND_IN_BARRIER = {BarrierType::DownAndIn, 90.0};
+const int WORKERS = 4;
 
 void run_sim(Simulation *simulator, void (Simulation::*func)(), bool is_fixed_strike) {
   (simulator->*func)();
@@ -106,6 +110,110 @@ void run_lookback_floating_strike_sim(std::shared_ptr<MonteCarlo> mc) {
   s = nullptr;
 }
 
+void run_bermudan_asian_fixed_strike_sim(std::shared_ptr<MonteCarlo> mc) {
+  Simulation *s = new Simulation("Bermudan Asian Option Fixed Strike", TIMESTEPS, SIMULATIONS, mc, INITIAL_OTION_PARAMETERS);
+  run_sim(s, &Simulation::simulate_bermudan_asian_option_fixed_strike, true);
+
+  delete s;
+  s = nullptr;
+}
+
+void run_bermudan_asian_floating_strike_sim(std::shared_ptr<MonteCarlo> mc) {
+  Simulation *s = new Simulation("Bermudan Asian Option floating Strike", TIMESTEPS, SIMULATIONS, mc, INITIAL_OTION_PARAMETERS);
+  run_sim(s, &Simulation::simulate_bermudan_asian_option_floating_strike, false);
+
+  delete s;
+  s = nullptr;
+}
+
+void run_bermudan_lookback_fixed_strike_sim(std::shared_ptr<MonteCarlo> mc) {
+  Simulation *s = new Simulation("Bermudan Lookback Option Fixed Strike", TIMESTEPS, SIMULATIONS, mc, INITIAL_OTION_PARAMETERS);
+  run_sim(s, &Simulation::simulate_bermudan_lookback_option_fixed_strike, true);
+
+  delete s;
+  s = nullptr;
+}
+
+void run_bermudan_lookback_floating_strike_sim(std::shared_ptr<MonteCarlo> mc) {
+  Simulation *s = new Simulation("Bermudan Lookback Option floating Strike", TIMESTEPS, SIMULATIONS, mc, INITIAL_OTION_PARAMETERS);
+  run_sim(s, &Simulation::simulate_bermudan_lookback_option_floating_strike, false);
+
+  delete s;
+  s = nullptr;
+}
+
+void run_barrier_asian_fixed_strike_sim(std::shared_ptr<MonteCarlo> mc) {
+  Simulation *s = new Simulation("Up-and-Out Asian Option Fixed Strike", TIMESTEPS, SIMULATIONS, mc, INITIAL_OTION_PARAMETERS);
+  s->change_barrier(UP_AND_OUT_BARRIER);
+  run_sim(s, &Simulation::simulate_barrier_asian_option_fixed_strike, true);
+
+  delete s;
+  s = nullptr;
+}
+
+void run_barrier_asian_floating_strike_sim(std::shared_ptr<MonteCarlo> mc) {
+  Simulation *s = new Simulation("Up-and-Out Asian Option floating Strike", TIMESTEPS, SIMULATIONS, mc, INITIAL_OTION_PARAMETERS);
+  s->change_barrier(UP_AND_OUT_BARRIER);
+  run_sim(s, &Simulation::simulate_barrier_asian_option_floating_strike, false);
+
+  delete s;
+  s = nullptr;
+}
+
+void run_barrier_lookback_fixed_strike_sim(std::shared_ptr<MonteCarlo> mc) {
+  Simulation *s = new Simulation("Down-and-In Lookback Option Fixed Strike", TIMESTEPS, SIMULATIONS, mc, INITIAL_OTION_PARAMETERS);
+  s->change_barrier(DOWN_AND_IN_BARRIER);
+  run_sim(s, &Simulation::simulate_barrier_lookback_option_fixed_strike, true);
+
+  delete s;
+  s = nullptr;
+}
+
+void run_barrier_lookback_floating_strike_sim(std::shared_ptr<MonteCarlo> mc) {
+  Simulation *s = new Simulation("Down-and-In Lookback Option floating Strike", TIMESTEPS, SIMULATIONS, mc, INITIAL_OTION_PARAMETERS);
+  s->change_barrier(DOWN_AND_IN_BARRIER);
+  run_sim(s, &Simulation::simulate_barrier_lookback_option_floating_strike, false);
+
+  delete s;
+  s = nullptr;
+}
+
+void run_distributed_asian_fixed_strike_sim(std::shared_ptr<MonteCarlo> mc) {
+  Simulation *s = new Simulation("Distributed Asian Option Fixed Strike", TIMESTEPS, SIMULATIONS, mc, INITIAL_OTION_PARAMETERS);
+  s->change_workers(WORKERS);
+  run_sim(s, &Simulation::simulate_distributed_asian_option_fixed_strike, true);
+
+  delete s;
+  s = nullptr;
+}
+
+void run_distributed_asian_floating_strike_sim(std::shared_ptr<MonteCarlo> mc) {
+  Simulation *s = new Simulation("Distributed Asian Option floating Strike", TIMESTEPS, SIMULATIONS, mc, INITIAL_OTION_PARAMETERS);
+  s->change_workers(WORKERS);
+  run_sim(s, &Simulation::simulate_distributed_asian_option_floating_strike, false);
+
+  delete s;
+  s = nullptr;
+}
+
+void run_distributed_lookback_fixed_strike_sim(std::shared_ptr<MonteCarlo> mc) {
+  Simulation *s = new Simulation("Distributed Lookback Option Fixed Strike", TIMESTEPS, SIMULATIONS, mc, INITIAL_OTION_PARAMETERS);
+  s->change_workers(WORKERS);
+  run_sim(s, &Simulation::simulate_distributed_lookback_option_fixed_strike, true);
+
+  delete s;
+  s = nullptr;
+}
+
+void run_distributed_lookback_floating_strike_sim(std::shared_ptr<MonteCarlo> mc) {
+  Simulation *s = new Simulation("Distributed Lookback Option floating Strike", TIMESTEPS, SIMULATIONS, mc, INITIAL_OTION_PARAMETERS);
+  s->change_workers(WORKERS);
+  run_sim(s, &Simulation::simulate_distributed_lookback_option_floating_strike, false);
+
+  delete s;
+  s = nullptr;
+}
+
 int main() {
   std::shared_ptr<MonteCarlo> mc = std::make_shared<MonteCarlo>();
 
@@ -113,6 +221,18 @@ int main() {
   run_asian_floating_strike_sim(mc);
   run_lookback_fixed_strike(mc);
   run_lookback_floating_strike_sim(mc);
+  run_bermudan_asian_fixed_strike_sim(mc);
+  run_bermudan_asian_floating_strike_sim(mc);
+  run_bermudan_lookback_fixed_strike_sim(mc);
+  run_bermudan_lookback_floating_strike_sim(mc);
+  run_barrier_asian_fixed_strike_sim(mc);
+  run_barrier_asian_floating_strike_sim(mc);
+  run_barrier_lookback_fixed_strike_sim(mc);
+  run_barrier_lookback_floating_strike_sim(mc);
+  run_distributed_asian_fixed_strike_sim(mc);
+  run_distributed_asian_floating_strike_sim(mc);
+  run_distributed_lookback_fixed_strike_sim(mc);
+  run_distributed_lookback_floating_strike_sim(mc);
 
   return 0;
 }
\ No newline at end of file